@@ -0,0 +1,108 @@
+#include "Canvas.h"
+#include "Frame.h"
+#include "Overdraw.h"
+
+// -------------------- CountingCanvas --------------------
+CountingCanvas::CountingCanvas(Canvas& inner, OverdrawMap& map)
+    : Canvas(inner.Dpi()), inner_(inner), map_(map) {}
+
+void CountingCanvas::Count(const Rect& r) {
+    map_.AddRect(r.left, r.top, r.right, r.bottom);
+}
+
+void CountingCanvas::Fill(const Rect& r, Color c) {
+    inner_.Fill(r, c);
+    Count(r);
+}
+
+void CountingCanvas::Rounded(const Rect& r, int radius, Color fill, Color border) {
+    inner_.Rounded(r, radius, fill, border);
+    Count(r);
+}
+
+void CountingCanvas::HLine(int left, int right, int y, Color c) {
+    inner_.HLine(left, right, y, c);
+    Count(Rect{ left, y, right, y + 1 });
+}
+
+void CountingCanvas::Text(FontId font, Color c, int x, int y, const std::wstring& s) {
+    inner_.Text(font, c, x, y, s);
+    Extent sz = inner_.Measure(font, s);
+    Count(Rect{ x, y, x + sz.cx, y + sz.cy });
+}
+
+Extent CountingCanvas::Measure(FontId font, const std::wstring& s) {
+    return inner_.Measure(font, s);
+}
+
+void CountingCanvas::Paragraph(int x, int y, int w, const std::wstring& text) {
+    inner_.Paragraph(x, y, w, text);
+    Count(Rect{ x, y, x + w, y + inner_.ParagraphHeight(w, text) });
+}
+
+int CountingCanvas::ParagraphHeight(int w, const std::wstring& text) {
+    return inner_.ParagraphHeight(w, text);
+}
+
+// Una imagen escalada pinta cada pxel del destino una vez: una operacin
+Rect CountingCanvas::Image(const Rect& dest, int resId) {
+    Rect r = inner_.Image(dest, resId);
+    Count(r);
+    return r;
+}
+
+void CountingCanvas::Header(const Rect& r) {
+    PaintHeaderLayer(*this, r);
+}
+
+void CountingCanvas::SetClip(const Rect& r) {
+    inner_.SetClip(r);
+    map_.SetClip(r.left, r.top, r.right, r.bottom);
+}
+
+void CountingCanvas::ClearClip() {
+    inner_.ClearClip();
+    map_.ClearClip();
+}
+
+// -------------------- RecordingCanvas --------------------
+// Mismos puntos que MakeFont en Ui.cpp
+int RecordingCanvas::EmPx(FontId font) const {
+    int pts = font == FONT_TITLE ? 24 : font == FONT_TEXT ? 11 : 9;
+    return (pts * Dpi() + 36) / 72;
+}
+
+void RecordingCanvas::SetImageSize(int resId, int w, int h) {
+    images_[resId] = Extent{ w, h };
+}
+
+Extent RecordingCanvas::Measure(FontId font, const std::wstring& s) {
+    int em = EmPx(font);
+    return Extent{ (int)s.size() * em / 2, em * 4 / 3 };
+}
+
+// Word-wrap como DT_WORDBREAK: corta entre palabras y una palabra ms ancha
+// que la lnea queda sola en la suya
+int RecordingCanvas::ParagraphHeight(int w, const std::wstring& text) {
+    int em = EmPx(FONT_TEXT);
+    int charW = em / 2 > 0 ? em / 2 : 1;
+    int perLine = w / charW > 0 ? w / charW : 1;
+    int lines = 1, used = 0;
+    size_t i = 0;
+    while (i < text.size()) {
+        size_t end = text.find(L' ', i);
+        if (end == std::wstring::npos) end = text.size();
+        int word = (int)(end - i);
+        if (used == 0) used = word;
+        else if (used + 1 + word <= perLine) used += 1 + word;
+        else { ++lines; used = word; }
+        i = end + 1;
+    }
+    return lines * (em * 4 / 3);
+}
+
+Rect RecordingCanvas::Image(const Rect& dest, int resId) {
+    auto it = images_.find(resId);
+    if (it == images_.end()) return dest;
+    return FitImage(dest, it->second.cx, it->second.cy);
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+
+// Superficie de dibujo del frame. PaintFrame (Frame.cpp) solo habla con esta
+// interfaz: en Windows la implementa GdiCanvas (Ui.cpp) y en cualquier
+// plataforma RecordingCanvas, que no pinta nada y solo produce rectngulos.
+// No depende de Win32.
+
+// Mismo orden de campos que RECT; semiabierto [left, right) x [top, bottom)
+struct Rect { int left, top, right, bottom; };
+
+inline bool Contains(const Rect& r, int x, int y) {
+    return x >= r.left && x < r.right && y >= r.top && y < r.bottom;
+}
+inline Rect Inflate(const Rect& r, int dx, int dy) {
+    return Rect{ r.left - dx, r.top - dy, r.right + dx, r.bottom + dy };
+}
+inline Rect Offset(const Rect& r, int dx, int dy) {
+    return Rect{ r.left + dx, r.top + dy, r.right + dx, r.bottom + dy };
+}
+
+// 0x00BBGGRR, igual que COLORREF
+typedef std::uint32_t Color;
+inline Color Rgb(int r, int g, int b) { return (Color)(r | (g << 8) | (b << 16)); }
+
+enum FontId { FONT_TITLE, FONT_TEXT, FONT_SMALL };
+
+struct Extent { int cx, cy; };
+
+// px a 96 dpi -> px al dpi pedido, redondeando como MulDiv
+inline int ScaleDpi(int px, int dpi) {
+    long long v = (long long)px * dpi;
+    return (int)(v >= 0 ? (v + 48) / 96 : -((-v + 48) / 96));
+}
+
+class Canvas {
+public:
+    explicit Canvas(int dpi) : dpi_(dpi) {}
+    virtual ~Canvas() {}
+
+    int Dpi() const { return dpi_; }
+    int S(int px) const { return ScaleDpi(px, dpi_); }
+
+    virtual void Fill(const Rect& r, Color c) = 0;
+    // radius ya escalado
+    virtual void Rounded(const Rect& r, int radius, Color fill, Color border) = 0;
+    // Lnea de 1 px de alto en y, de left a right
+    virtual void HLine(int left, int right, int y, Color c) = 0;
+    virtual void Text(FontId font, Color c, int x, int y, const std::wstring& s) = 0;
+    virtual Extent Measure(FontId font, const std::wstring& s) = 0;
+    // Prrafo con word-wrap en FONT_TEXT
+    virtual void Paragraph(int x, int y, int w, const std::wstring& text) = 0;
+    virtual int ParagraphHeight(int w, const std::wstring& text) = 0;
+    // Imagen del recurso dentro de dest manteniendo el aspecto; devuelve el rect
+    // realmente pintado (vaco si no se pudo cargar)
+    virtual Rect Image(const Rect& dest, int resId) = 0;
+    // Capa del header (PaintHeaderLayer); GdiCanvas la cachea por set de DPI
+    virtual void Header(const Rect& r) = 0;
+    virtual void SetClip(const Rect& r) = 0;
+    virtual void ClearClip() = 0;
+
+private:
+    int dpi_;
+};
+
+class OverdrawMap;
+
+// Decorador que pasa cada operacin al canvas de adentro y suma su rect en un
+// OverdrawMap. Las medidas (texto, prrafos, imgenes) son las del canvas de
+// adentro. El header se pinta con sus operaciones reales en vez de copiar la
+// capa cacheada, para que el sobre-pintado de la capa se vea.
+class CountingCanvas : public Canvas {
+public:
+    CountingCanvas(Canvas& inner, OverdrawMap& map);
+
+    void Fill(const Rect& r, Color c) override;
+    void Rounded(const Rect& r, int radius, Color fill, Color border) override;
+    void HLine(int left, int right, int y, Color c) override;
+    void Text(FontId font, Color c, int x, int y, const std::wstring& s) override;
+    Extent Measure(FontId font, const std::wstring& s) override;
+    void Paragraph(int x, int y, int w, const std::wstring& text) override;
+    int ParagraphHeight(int w, const std::wstring& text) override;
+    Rect Image(const Rect& dest, int resId) override;
+    void Header(const Rect& r) override;
+    void SetClip(const Rect& r) override;
+    void ClearClip() override;
+
+private:
+    void Count(const Rect& r);
+    Canvas& inner_;
+    OverdrawMap& map_;
+};
+
+// Canvas sin salida con mtricas de fuente fijas (Segoe UI aproximada: alto de
+// lnea 4/3 del em, ancho medio de carcter 1/2 del em) para medir frames sin
+// GDI. Las imgenes usan el tamao registrado con SetImageSize; sin tamao
+// ocupan todo el rect destino.
+class RecordingCanvas : public Canvas {
+public:
+    explicit RecordingCanvas(int dpi) : Canvas(dpi) {}
+
+    void SetImageSize(int resId, int w, int h);
+
+    void Fill(const Rect&, Color) override {}
+    void Rounded(const Rect&, int, Color, Color) override {}
+    void HLine(int, int, int, Color) override {}
+    void Text(FontId, Color, int, int, const std::wstring&) override {}
+    Extent Measure(FontId font, const std::wstring& s) override;
+    void Paragraph(int, int, int, const std::wstring&) override {}
+    int ParagraphHeight(int w, const std::wstring& text) override;
+    Rect Image(const Rect& dest, int resId) override;
+    void Header(const Rect&) override {}
+    void SetClip(const Rect&) override {}
+    void ClearClip() override {}
+
+private:
+    int EmPx(FontId font) const;
+    std::map<int, Extent> images_;
+};
@@ -0,0 +1,141 @@
+#include "DibView.h"
+
+static const std::uint32_t kBiRgb = 0;
+static const std::uint32_t kBiBitfields = 3;
+static const std::size_t kFileHeaderSize = 14;
+static const std::size_t kInfoHeaderSize = 40;
+
+static std::uint16_t ReadU16(const std::uint8_t* p) {
+    return (std::uint16_t)(p[0] | (p[1] << 8));
+}
+
+static std::uint32_t ReadU32(const std::uint8_t* p) {
+    return (std::uint32_t)p[0] | ((std::uint32_t)p[1] << 8)
+         | ((std::uint32_t)p[2] << 16) | ((std::uint32_t)p[3] << 24);
+}
+
+// Cabecera + paleta/mscaras; bitsOffset = 0 calcula dnde empiezan los pxeles
+static bool ParseDib(const std::uint8_t* p, std::size_t size, std::size_t bitsOffset, DibView& out) {
+    if (size < kInfoHeaderSize) return false;
+    std::uint32_t headerSize = ReadU32(p);
+    // BITMAPINFOHEADER (40), V2/V3 (52/56), V4 (108), V5 (124); no BITMAPCOREHEADER
+    if (headerSize < kInfoHeaderSize || headerSize > size) return false;
+
+    DibView d;
+    d.info = p;
+    std::int32_t w = (std::int32_t)ReadU32(p + 4);
+    std::int32_t h = (std::int32_t)ReadU32(p + 8);
+    std::uint16_t planes = ReadU16(p + 12);
+    d.bitCount = ReadU16(p + 14);
+    d.compression = ReadU32(p + 16);
+    std::uint32_t clrUsed = ReadU32(p + 32);
+
+    if (planes != 1 || w <= 0 || h == 0 || h == INT32_MIN) return false;
+    d.width = w;
+    d.bottomUp = h > 0;
+    d.height = h > 0 ? h : -h;
+
+    switch (d.bitCount) {
+    case 1: case 4: case 8: case 24:
+        if (d.compression != kBiRgb) return false;
+        break;
+    case 16: case 32:
+        if (d.compression != kBiRgb && d.compression != kBiBitfields) return false;
+        break;
+    default:
+        return false; // RLE, JPEG/PNG embebidos, etc.
+    }
+
+    std::size_t offset = headerSize;
+    if (d.compression == kBiBitfields) {
+        // Con BITMAPINFOHEADER las mscaras van despus; en V2+ ya estn en la cabecera
+        const std::uint8_t* m = p + kInfoHeaderSize;
+        if (headerSize == kInfoHeaderSize) {
+            if (size < offset + 12) return false;
+            offset += 12;
+        }
+        d.masks[0] = ReadU32(m); d.masks[1] = ReadU32(m + 4); d.masks[2] = ReadU32(m + 8);
+    }
+    else if (d.bitCount == 16) {
+        d.masks[0] = 0x7C00; d.masks[1] = 0x03E0; d.masks[2] = 0x001F; // 5-5-5
+    }
+    else if (d.bitCount == 32) {
+        d.masks[0] = 0x00FF0000; d.masks[1] = 0x0000FF00; d.masks[2] = 0x000000FF;
+    }
+
+    // La paleta ocupa biClrUsed entradas (2^bitCount si es 0 y hay paleta) aunque
+    // el formato no pueda indexarlas todas; solo se expone la parte utilizable
+    std::uint32_t entries = clrUsed;
+    if (d.bitCount <= 8) {
+        std::uint32_t maxColors = 1u << d.bitCount;
+        if (entries == 0) entries = maxColors;
+        d.paletteSize = entries > maxColors ? maxColors : entries;
+    }
+    else d.paletteSize = entries > 256 ? 256 : entries; // paleta opcional, solo informativa
+    if ((size - offset) / 4 < entries) return false;
+    if (d.paletteSize) d.palette = p + offset;
+    offset += (std::size_t)entries * 4;
+
+    // bfOffBits no puede caer dentro de la cabecera o la paleta
+    if (bitsOffset) {
+        if (bitsOffset < offset) return false;
+        offset = bitsOffset;
+    }
+    d.stride = (((std::size_t)d.width * d.bitCount + 31) / 32) * 4;
+    if (offset > size || (size - offset) / d.stride < (std::size_t)d.height) return false;
+    d.bits = p + offset;
+
+    out = d;
+    return true;
+}
+
+bool ParsePackedDib(const void* data, std::size_t size, DibView& out) {
+    if (!data) return false;
+    return ParseDib((const std::uint8_t*)data, size, 0, out);
+}
+
+bool ParseBmpFile(const void* data, std::size_t size, DibView& out) {
+    const std::uint8_t* p = (const std::uint8_t*)data;
+    if (!p || size < kFileHeaderSize || p[0] != 'B' || p[1] != 'M') return false;
+    std::uint32_t bfOffBits = ReadU32(p + 10);
+    if (bfOffBits < kFileHeaderSize + kInfoHeaderSize || bfOffBits > size) return false;
+    return ParseDib(p + kFileHeaderSize, size - kFileHeaderSize, bfOffBits - kFileHeaderSize, out);
+}
+
+const std::uint8_t* DibRow(const DibView& dib, int y) {
+    int row = dib.bottomUp ? (dib.height - 1 - y) : y;
+    return dib.bits + (std::size_t)row * dib.stride;
+}
+
+// Escala un canal enmascarado a 0..255
+static std::uint32_t Channel(std::uint32_t v, std::uint32_t mask) {
+    if (!mask) return 0;
+    int shift = 0;
+    while (!(mask & 1u)) { mask >>= 1; ++shift; }
+    std::uint32_t c = (v >> shift) & mask;
+    return mask == 0xFF ? c : (c * 255 + mask / 2) / mask;
+}
+
+std::uint32_t DibPixel(const DibView& dib, int x, int y) {
+    const std::uint8_t* row = DibRow(dib, y);
+    switch (dib.bitCount) {
+    case 24: {
+        const std::uint8_t* px = row + x * 3; // BGR
+        return ((std::uint32_t)px[2] << 16) | ((std::uint32_t)px[1] << 8) | px[0];
+    }
+    case 16:
+    case 32: {
+        std::uint32_t v = dib.bitCount == 16 ? ReadU16(row + x * 2) : ReadU32(row + x * 4);
+        return (Channel(v, dib.masks[0]) << 16) | (Channel(v, dib.masks[1]) << 8) | Channel(v, dib.masks[2]);
+    }
+    default: {
+        int perByte = 8 / dib.bitCount;
+        std::uint8_t b = row[x / perByte];
+        int shift = (perByte - 1 - x % perByte) * dib.bitCount;
+        std::uint32_t index = (b >> shift) & ((1u << dib.bitCount) - 1);
+        if (index >= dib.paletteSize) return 0;
+        const std::uint8_t* q = dib.palette + index * 4; // RGBQUAD = B, G, R, 0
+        return ((std::uint32_t)q[2] << 16) | ((std::uint32_t)q[1] << 8) | q[0];
+    }
+    }
+}
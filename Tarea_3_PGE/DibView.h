@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Vista de solo lectura sobre un DIB empaquetado (cabecera + paleta/mscaras +
+// pxeles), tal como queda mapeado un recurso RT_BITMAP dentro del ejecutable.
+// No copia nada y no depende de Win32.
+struct DibView {
+    const std::uint8_t* info = nullptr;    // BITMAPINFOHEADER (sirve como BITMAPINFO*)
+    const std::uint8_t* palette = nullptr; // RGBQUAD[paletteSize], o nullptr
+    const std::uint8_t* bits = nullptr;    // primera fila en memoria
+    int width = 0;
+    int height = 0;                        // siempre positivo
+    int bitCount = 0;                      // 1, 4, 8, 16, 24 o 32
+    std::uint32_t compression = 0;         // 0 = BI_RGB, 3 = BI_BITFIELDS
+    std::uint32_t paletteSize = 0;
+    std::uint32_t masks[3] = { 0, 0, 0 };  // R, G, B (16/32 bits)
+    std::size_t stride = 0;                // bytes por fila, con padding a 4
+    bool bottomUp = true;                  // biHeight > 0: la primera fila es la de abajo
+};
+
+// Recurso RT_BITMAP: empieza directamente en la cabecera
+bool ParsePackedDib(const void* data, std::size_t size, DibView& out);
+
+// Archivo .bmp: BITMAPFILEHEADER (14 bytes) + DIB empaquetado
+bool ParseBmpFile(const void* data, std::size_t size, DibView& out);
+
+// Fila y en orden visual (0 = arriba), sin importar la orientacin en memoria
+const std::uint8_t* DibRow(const DibView& dib, int y);
+
+// Color del pxel como 0x00RRGGBB
+std::uint32_t DibPixel(const DibView& dib, int x, int y);
@@ -0,0 +1,344 @@
+#include "Frame.h"
+#include <algorithm>
+
+// -------------------- Layout --------------------
+Rect SectionBarRect(const Rect& rcClient, int dpi) {
+    Rect r = rcClient;
+    r.top += ScaleDpi(kHeaderHeight, dpi);
+    r.bottom = r.top + ScaleDpi(kSectionBarHeight, dpi);
+    return r;
+}
+
+std::vector<Rect> BuildTabRects(const Rect& bar) {
+    int count = (int)(sizeof(kTabs) / sizeof(kTabs[0]));
+    int w = (bar.right - bar.left) / count;
+    std::vector<Rect> out; out.reserve(count);
+    for (int i = 0; i < count; i++) {
+        Rect r{ bar.left + i * w, bar.top, bar.left + (i + 1) * w, bar.bottom };
+        out.push_back(r);
+    }
+    return out;
+}
+
+// rea de contenido (card) coherente para pintar y para hit-testing
+static Rect GetContentCardRect(const Canvas& c, const Rect& rcClient) {
+    Rect bar = SectionBarRect(rcClient, c.Dpi());
+    Rect content{ rcClient.left + c.S(24), bar.bottom + c.S(20), rcClient.right - c.S(24), rcClient.bottom - c.S(24) };
+    return Inflate(content, -c.S(4), -c.S(4));
+}
+
+Rect FitImage(const Rect& dest, int srcW, int srcH) {
+    int dstW = dest.right - dest.left;
+    int dstH = dest.bottom - dest.top;
+    if (srcW <= 0 || srcH <= 0) return Rect{ dest.left, dest.top, dest.left, dest.top };
+    double k = std::min((double)dstW / srcW, (double)dstH / srcH);
+    int w = std::max(1, (int)(srcW * k));
+    int h = std::max(1, (int)(srcH * k));
+    int x = dest.left + (dstW - w) / 2;
+    int y = dest.top + (dstH - h) / 2;
+    return Rect{ x, y, x + w, y + h };
+}
+
+// -------------------- Pintado --------------------
+void PaintHeaderLayer(Canvas& c, const Rect& r) {
+    int h = r.bottom - r.top;
+    for (int i = 0; i < h; i++) {
+        int g = 220 - (i * 120) / std::max(1, h);
+        c.HLine(r.left, r.right, r.top + i, Rgb(245, g, 120));
+    }
+
+    c.Text(FONT_TITLE, Rgb(40, 40, 40), c.S(24), r.top + c.S(26), L"Cantina Chichilo");
+    c.Text(FONT_TEXT, Rgb(60, 60, 60), c.S(26), r.top + c.S(66), L"Una familia para servirlo desde 1956");
+}
+
+static void PaintSectionBar(Canvas& c, const Rect& rcClient, Section section) {
+    Rect bar = SectionBarRect(rcClient, c.Dpi());
+    c.Fill(bar, Rgb(250, 246, 240));
+    auto rects = BuildTabRects(bar);
+    for (size_t i = 0; i < rects.size(); ++i) {
+        const auto& t = kTabs[i];
+        Rect r = rects[i];
+        bool active = (section == t.id);
+        if (active) {
+            Rect rr = Inflate(r, -c.S(8), -c.S(8));
+            c.Rounded(rr, c.S(12), Rgb(255, 255, 255), Rgb(230, 180, 120));
+        }
+        Extent sz = c.Measure(FONT_TEXT, t.label);
+        int cx = (r.left + r.right - sz.cx) / 2;
+        int cy = (r.top + r.bottom - sz.cy) / 2;
+        c.Text(FONT_TEXT, Rgb(60, 50, 40), cx, cy, t.label);
+    }
+}
+
+// -------------------- Contenido --------------------
+static void PaintContent(Canvas& c, const Rect& rcClient, const UiSnapshot& snap, LayoutResult& out) {
+    Rect card = GetContentCardRect(c, rcClient);
+
+    // Sombra + card
+    Rect shadow = Offset(card, c.S(3), c.S(3));
+    c.Fill(shadow, Rgb(230, 230, 230));
+    c.Rounded(card, c.S(16), Rgb(255, 255, 255), Rgb(235, 215, 190));
+
+    int pad = c.S(20);
+    int x = card.left + pad;
+    int y = card.top + pad;
+    int w = (card.right - card.left) - 2 * pad;
+
+    // Clip y offset de scroll SIEMPRE
+    Rect clip = Inflate(card, -c.S(8), -c.S(8));
+    c.SetClip(clip);
+    const int yOff = -snap.scrollPos;
+
+    // Inicializamos viewport y contenido
+    out.viewportH = card.bottom - card.top;
+    out.contentH = out.viewportH;
+
+    switch (snap.section) {
+    case SEC_INICIO: {
+        int yCur = y;
+
+        // Ttulo
+        c.Text(FONT_TITLE, Rgb(30, 30, 30), x, yCur + yOff, L"Bienvenido a la Cantina");
+        yCur += c.S(40);
+
+        // ===== Columna derecha: FRENTE =====
+        const int rightColW = c.S(420);
+        const int imgH = c.S(320);
+
+        Rect imgRect{
+            card.right - pad - rightColW,
+            y + yOff,                // alineado arriba del contenido (como en Contacto)
+            card.right - pad,
+            y + imgH + yOff
+        };
+        c.Rounded(imgRect, c.S(12), Rgb(255, 255, 255), Rgb(235, 215, 190));
+        Rect imgInner = Inflate(imgRect, -c.S(14), -c.S(14));
+        c.Image(imgInner, IDB_FRENTE);
+
+        // ===== Columna izquierda: texto =====
+        const int leftColW = w - (rightColW + c.S(20)); // deja un gap entre columnas
+        std::wstring p1 = L"Clsico bodegn porteo en La Paternal...";
+        c.Paragraph(x, yCur + yOff, leftColW, p1);
+        int h1 = c.ParagraphHeight(leftColW, p1);
+
+        // Alto lgico total = lo ms bajo entre texto e imagen
+        int logicalBottom = std::max(yCur + h1, (imgRect.bottom - yOff)) + c.S(20);
+        out.contentH = (logicalBottom - card.top) + c.S(10);
+    } break;
+
+    case SEC_CARTA: {
+        c.Text(FONT_TITLE, Rgb(30, 30, 30), x, y + yOff, L"Nuestra Carta");
+        int yAfterTitle = y + c.S(44);
+
+        // Bsqueda: se tipea directamente sobre la Carta (Esc borra)
+        if (snap.busqueda.empty())
+            c.Text(FONT_SMALL, Rgb(150, 140, 130), x, yAfterTitle + yOff, L"Escriba para buscar un plato");
+        else
+            c.Text(FONT_SMALL, Rgb(60, 50, 40), x, yAfterTitle + yOff, L"Buscar: " + snap.busqueda + L"_");
+        yAfterTitle += c.S(28);
+
+        // Columnas: izquierda = lista, derecha = imagen
+        const int leftColW = c.S(300);
+        const int buttonH = c.S(36);
+        const int buttonGap = c.S(12);
+
+        Rect imgRect{
+            card.right - pad - c.S(400),
+            card.top + pad + yOff,
+            card.right - pad,
+            card.top + pad + c.S(300) + yOff
+        };
+
+        // ---- Lista de PLATOS ----
+        out.platoRects.clear();
+        int yBtn = yAfterTitle;
+        for (int i : snap.platos) {
+            const auto& p = kPlatos[i];
+            Rect logical{ x, yBtn, x + leftColW, yBtn + buttonH };
+            Rect r = Offset(logical, 0, yOff);
+            out.platoRects.push_back(r);
+            out.platoIndex.push_back(i);
+
+            Color fondo = (snap.plato == p.id) ? Rgb(255, 245, 230) : Rgb(255, 255, 255);
+            c.Rounded(r, c.S(8), fondo, Rgb(210, 190, 160));
+            c.Text(FONT_TEXT, Rgb(30, 30, 30), r.left + c.S(12), r.top + (buttonH / 4), p.nombre);
+
+            yBtn += buttonH + buttonGap;
+        }
+        if (snap.platos.empty()) {
+            c.Text(FONT_TEXT, Rgb(120, 110, 100), x, yBtn + yOff, L"Sin resultados");
+            yBtn += buttonH + buttonGap;
+        }
+
+        // Marco + imagen Platos
+        c.Rounded(imgRect, c.S(12), Rgb(255, 255, 255), Rgb(235, 215, 190));
+        for (const auto& p : kPlatos) {
+            if (p.id == snap.plato) {
+                Rect inner = Inflate(imgRect, -c.S(14), -c.S(14));
+                c.Image(inner, p.recurso);
+                break;
+            }
+        }
+
+        // ---- ESPECIALIDADES ----
+        int yEspecialTitle = std::max(yBtn, (imgRect.bottom - yOff)) + c.S(36);
+        c.Text(FONT_TITLE, Rgb(30, 30, 30), x, yEspecialTitle + yOff, L"Nuestras Especialidades");
+
+        int yEspBtns = yEspecialTitle + c.S(44);
+
+        Rect imgRectEsp{
+            card.right - pad - c.S(400),
+            yEspecialTitle + yOff,
+            card.right - pad,
+            yEspecialTitle + c.S(280) + yOff
+        };
+
+        out.especialRects.clear();
+        int yBtnEsp = yEspBtns;
+        for (int i : snap.especiales) {
+            const auto& e = kEspeciales[i];
+            Rect logical{ x, yBtnEsp, x + leftColW, yBtnEsp + buttonH };
+            Rect r = Offset(logical, 0, yOff);
+            out.especialRects.push_back(r);
+            out.especialIndex.push_back(i);
+
+            Color fondo = (snap.especial == e.id) ? Rgb(255, 245, 230) : Rgb(255, 255, 255);
+            c.Rounded(r, c.S(8), fondo, Rgb(210, 190, 160));
+            c.Text(FONT_TEXT, Rgb(30, 30, 30), r.left + c.S(12), r.top + (buttonH / 4), e.nombre);
+
+            yBtnEsp += buttonH + buttonGap;
+        }
+        if (snap.especiales.empty()) {
+            c.Text(FONT_TEXT, Rgb(120, 110, 100), x, yBtnEsp + yOff, L"Sin resultados");
+            yBtnEsp += buttonH + buttonGap;
+        }
+
+        // Marco + imagen Especialidad
+        c.Rounded(imgRectEsp, c.S(12), Rgb(255, 255, 255), Rgb(235, 215, 190));
+        for (const auto& e : kEspeciales) {
+            if (e.id == snap.especial) {
+                Rect inner = Inflate(imgRectEsp, -c.S(14), -c.S(14));
+                c.Image(inner, e.recurso);
+                break;
+            }
+        }
+
+        int logicalBottom = std::max(yBtnEsp, (imgRectEsp.bottom - yOff)) + c.S(20);
+        out.contentH = (logicalBottom - card.top) + c.S(10);
+    } break;
+
+    case SEC_HISTORIA: {
+        int yCur = y;
+        c.Text(FONT_TITLE, Rgb(30, 30, 30), x, yCur + yOff, L"Historia");
+        yCur += c.S(60);
+
+        int lastBottom = yCur;
+
+        std::wstring p1 = L"- Desde 1956, Cantina Chichilo es un cono de barrio...";
+        c.Paragraph(x, yCur + yOff, w, p1);
+        int h1 = c.ParagraphHeight(w, p1);
+        lastBottom = std::max(lastBottom, yCur + h1);
+        yCur += c.S(40);
+
+        std::wstring p2 = L"- Ganadora de los premios Clarin y Martin Fierro 2005";
+        c.Paragraph(x, yCur + yOff, w, p2);
+        int h2 = c.ParagraphHeight(w, p2);
+        lastBottom = std::max(lastBottom, yCur + h2);
+        yCur += c.S(40);
+
+        std::wstring p3 = L"- Cantina Chichilo de Buenos Aires desde hace 65 aos al servicio del buen comer atendidos por sus dueos en un barrio de famosos La Paternal. Adems la produccin de pol-ka la eligi para la apertura de la novela ilusiones y el sodero de mi vida, adems es el lugar preferido de Diego Maradona";
+        c.Paragraph(x, yCur + yOff, w, p3);
+        int h3 = c.ParagraphHeight(w, p3);
+        lastBottom = std::max(lastBottom, yCur + h3);
+
+        int logicalBottom = std::max(lastBottom, yCur) + c.S(20);
+        out.contentH = (logicalBottom - card.top) + c.S(10);
+    } break;
+
+    case SEC_HORARIOS: {
+        int yCur = y;
+        c.Text(FONT_TITLE, Rgb(30, 30, 30), x, yCur + yOff, L"Horarios");
+        yCur += c.S(50);
+
+        const wchar_t* lines[] = {
+            L"- Lunes de 20:30 a 00:00 hs",
+            L"- Martes de 20:30 a 00:00 hs",
+            L"- Miercoles de 20:30 a 00:00 hs",
+            L"- Jueves de 20:30 a 00:00 hs",
+            L"- Viernes de 20:30 a 00:00 hs",
+            L"- Sbados de 12:30 a 14:30 hs",
+            L"- Domingos de 12:30 a 14:30 hs"
+        };
+        int lastBottom = yCur;
+        for (auto s : lines) {
+            std::wstring t = s;
+            c.Paragraph(x, yCur + yOff, w, t);
+            int ht = c.ParagraphHeight(w, t);
+            lastBottom = std::max(lastBottom, yCur + ht);
+            yCur += c.S(40);
+        }
+
+        int logicalBottom = std::max(lastBottom, yCur) + c.S(20);
+        out.contentH = (logicalBottom - card.top) + c.S(10);
+    } break;
+
+    case SEC_CONTACTO: {
+        int yCur = y;
+
+        // Ttulo
+        c.Text(FONT_TITLE, Rgb(30, 30, 30), x, yCur + yOff, L"Contacto");
+        yCur += c.S(50);
+
+        // ===== Columna derecha: MAPA =====
+        // Tamao sugerido del recuadro del mapa
+        const int rightColW = c.S(420);
+        const int mapH = c.S(320);
+
+        Rect mapRect{
+            card.right - pad - rightColW,
+            y + yOff,                      // alineado con el inicio del contenido
+            card.right - pad,
+            y + mapH + yOff
+        };
+        c.Rounded(mapRect, c.S(12), Rgb(255, 255, 255), Rgb(235, 215, 190));
+        Rect mapInner = Inflate(mapRect, -c.S(14), -c.S(14));
+        c.Image(mapInner, IDB_MAPA);
+
+        // ===== Columna izquierda: texto =====
+        const int leftColW = w - (rightColW + c.S(20)); // deja espacio para el mapa y un gap
+        const wchar_t* lines[] = {
+            L"Direccin: Camarones 1901, Esquina Terrero 2006",
+            L"Capital Federal",
+            L"Reservas: 011-4581-1984 / 011-4584-1263",
+            L"Email: cantinachichilo@cantinachichilo.com.ar",
+            L"Email: chichilo3554@hotmail.com"
+        };
+
+        int lastBottom = yCur;
+        for (auto s : lines) {
+            std::wstring t = s;
+            c.Paragraph(x, yCur + yOff, leftColW, t);
+            // Si ests usando mi versin con MeasureParagraphHeight:
+            int ht = c.ParagraphHeight(leftColW, t);
+            lastBottom = std::max(lastBottom, yCur + ht);
+            yCur += c.S(30);
+        }
+
+        // Alto lgico total: mximo entre texto y mapa
+        int logicalBottom = std::max(lastBottom, (mapRect.bottom - yOff)) + c.S(20);
+        out.contentH = (logicalBottom - card.top) + c.S(10);
+    } break;
+    }
+
+    // Quitar clip
+    c.ClearClip();
+}
+void PaintFrame(Canvas& c, const UiSnapshot& snap, LayoutResult& out) {
+    Rect rc{ 0, 0, snap.width, snap.height };
+    c.Fill(rc, Rgb(252, 250, 247));
+
+    out.scrollPos = snap.scrollPos;
+    c.Header(Rect{ rc.left, rc.top, rc.right, rc.top + c.S(kHeaderHeight) });
+    PaintSectionBar(c, rc, snap.section);
+    PaintContent(c, rc, snap, out);
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include "Canvas.h"
+#include "RenderState.h"
+#include "Resource.h"
+
+// Contenido y layout del frame, pintado sobre un Canvas. No depende de Win32:
+// lo usa el hilo de render (GdiCanvas) y el conteo de sobre-pintado en Linux
+// (RecordingCanvas).
+
+struct PlatoDef { Plato id; const wchar_t* nombre; int recurso; };
+
+static const PlatoDef kPlatos[] = {
+    { PLATO_RANAS,     L"Ranas a la provenzal",      IDB_RANAS },
+    { PLATO_CARACOLES, L"Caracoles a la Bordaleza",  IDB_CARACOLES },
+    { PLATO_RABAS,     L"Rabas a la Calabria",       IDB_RABAS },
+    { PLATO_MERLUZA,   L"Merluza al ajillo",         IDB_MERLUZA },
+    { PLATO_GAMBAS,    L"Gambas al Ajillo",          IDB_GAMBAS },
+};
+
+// ---- Especialidades ----
+struct EspDef { Especial id; const wchar_t* nombre; int recurso; };
+
+static const EspDef kEspeciales[] = {
+    { ESP_QUINOTOS,     L"Quinotos al Rhum con Helado de Americana", IDB_QUINTOS },
+    { ESP_MONDONGO,     L"Mondongo a la Italiana",                    IDB_MONDONGO },
+    { ESP_RINONES,      L"Riones al Vino Blanco",                    IDB_RINONES },
+    { ESP_CALAMARETTIS, L"Calamarettis a la Escarpetta",              IDB_CALAMARETTIS },
+};
+
+// ---- Tabs ----
+struct TabDef { Section id; const wchar_t* label; };
+static const TabDef kTabs[] = {
+    {SEC_INICIO,   L"Inicio"},
+    {SEC_CARTA,    L"Carta"},
+    {SEC_HISTORIA, L"Historia"},
+    {SEC_HORARIOS, L"Horarios"},
+    {SEC_CONTACTO, L"Contacto"},
+};
+
+static const int kHeaderHeight = 140;
+static const int kSectionBarHeight = 48;
+
+// Layout que produce un frame, para la barra de scroll y el hit-testing
+struct LayoutResult {
+    std::uint32_t seq = 0;           // seq del snapshot que produjo este layout
+    std::vector<Rect> platoRects;    // ya desplazados por scrollPos
+    std::vector<Rect> especialRects;
+    std::vector<int> platoIndex;     // a qu entrada de la tabla corresponde cada rect
+    std::vector<int> especialIndex;
+    int scrollPos = 0;               // scroll del snapshot que produjo este layout
+    int viewportH = 0;
+    int contentH = 0;
+};
+
+Rect SectionBarRect(const Rect& rcClient, int dpi);
+std::vector<Rect> BuildTabRects(const Rect& bar);
+
+// Rect centrado en dest con el aspecto de una imagen de srcW x srcH
+Rect FitImage(const Rect& dest, int srcW, int srcH);
+
+// Degradado y ttulos del header; r.top = arriba del header
+void PaintHeaderLayer(Canvas& c, const Rect& r);
+
+// Compone el frame completo del snapshot
+void PaintFrame(Canvas& c, const UiSnapshot& snap, LayoutResult& out);
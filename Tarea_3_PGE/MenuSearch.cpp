@@ -0,0 +1,77 @@
+#include "MenuSearch.h"
+
+// Plegado de Latin-1 (0xC0..0xFF); 0 = se deja igual
+static const char kLatin1Fold[64] = {
+    'a','a','a','a','a','a','a','c', 'e','e','e','e','i','i','i','i',
+    'd','n','o','o','o','o','o', 0,  'o','u','u','u','u','y', 0,  0,
+    'a','a','a','a','a','a','a','c', 'e','e','e','e','i','i','i','i',
+    'd','n','o','o','o','o','o', 0,  'o','u','u','u','u','y', 0, 'y',
+};
+
+std::wstring FoldText(const std::wstring& text) {
+    std::wstring out;
+    out.reserve(text.size());
+    for (wchar_t c : text) {
+        if (c >= L'A' && c <= L'Z') c = (wchar_t)(c - L'A' + L'a');
+        else if (c >= 0xC0 && c <= 0xFF && kLatin1Fold[c - 0xC0]) c = (wchar_t)kLatin1Fold[c - 0xC0];
+        out.push_back(c);
+    }
+    return out;
+}
+
+std::uint64_t MenuSearch::Trigram(const wchar_t* p) {
+    return ((std::uint64_t)(std::uint32_t)p[0] << 42)
+         | ((std::uint64_t)(std::uint32_t)p[1] << 21)
+         |  (std::uint64_t)(std::uint32_t)p[2];
+}
+
+std::uint32_t MenuSearch::Add(const std::wstring& name, const std::wstring& description) {
+    std::uint32_t id = (std::uint32_t)folded_.size();
+    // '\n' no sale del plegado ni se puede tipear: ningn trigrama de una consulta
+    // cruza del nombre a la descripcin
+    folded_.push_back(FoldText(description.empty() ? name : name + L'\n' + description));
+
+    const std::wstring& t = folded_.back();
+    for (size_t i = 0; i + 3 <= t.size(); ++i) {
+        auto& list = postings_[Trigram(&t[i])];
+        if (list.empty() || list.back() != id) list.push_back(id);
+    }
+    hasLast_ = false; // el resultado previo ya no cubre todo el ndice
+    return id;
+}
+
+const std::vector<std::uint32_t>& MenuSearch::Search(const std::wstring& query) {
+    std::wstring q = FoldText(query);
+    std::vector<std::uint32_t> result;
+
+    // Candidatos: el resultado anterior si q lo extiende (todo lo que contiene q
+    // contiene tambin la consulta previa) o la lista ms corta entre los trigramas
+    // de q; se usa la ms chica y se verifica con una bsqueda de subcadena.
+    const std::vector<std::uint32_t>* candidates = nullptr;
+    bool none = false;
+    if (hasLast_ && !lastQuery_.empty() && q.find(lastQuery_) != std::wstring::npos)
+        candidates = &lastResult_;
+    for (size_t i = 0; i + 3 <= q.size(); ++i) {
+        auto it = postings_.find(Trigram(&q[i]));
+        if (it == postings_.end()) { none = true; break; }
+        if (!candidates || it->second.size() < candidates->size()) candidates = &it->second;
+    }
+
+    if (none) {
+        // Algn trigrama no aparece en la carta: no hay resultados
+    }
+    else if (candidates) {
+        for (std::uint32_t id : *candidates)
+            if (folded_[id].find(q) != std::wstring::npos) result.push_back(id);
+    }
+    else {
+        // Menos de 3 letras y sin resultado previo: se recorre todo
+        for (std::uint32_t id = 0; id < (std::uint32_t)folded_.size(); ++id)
+            if (q.empty() || folded_[id].find(q) != std::wstring::npos) result.push_back(id);
+    }
+
+    lastQuery_ = q;
+    lastResult_.swap(result);
+    hasLast_ = true;
+    return lastResult_;
+}
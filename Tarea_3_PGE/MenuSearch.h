@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Bsqueda incremental sobre la carta. Los textos se pliegan (sin acentos,
+// minsculas) y se indexan por trigramas; no depende de Win32.
+
+// "Riones al Vino" -> "rinones al vino"
+std::wstring FoldText(const std::wstring& text);
+
+class MenuSearch {
+public:
+    // Agrega un plato; el id devuelto es su orden de insercin
+    std::uint32_t Add(const std::wstring& name, const std::wstring& description = L"");
+
+    // Ids (ordenados) de los platos que contienen la consulta. Si la consulta
+    // extiende a la anterior se refina el resultado previo en vez del ndice.
+    const std::vector<std::uint32_t>& Search(const std::wstring& query);
+
+    size_t Size() const { return folded_.size(); }
+
+private:
+    static std::uint64_t Trigram(const wchar_t* p);
+
+    std::vector<std::wstring> folded_;
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> postings_;
+    std::wstring lastQuery_;              // plegada
+    std::vector<std::uint32_t> lastResult_;
+    bool hasLast_ = false;
+};
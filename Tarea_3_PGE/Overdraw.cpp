@@ -0,0 +1,91 @@
+#include "Overdraw.h"
+#include <algorithm>
+#include <cwchar>
+
+void OverdrawMap::Reset(int width, int height) {
+    width_ = std::max(0, width);
+    height_ = std::max(0, height);
+    counts_.assign((std::size_t)width_ * height_, 0);
+    clipped_ = false;
+    ops_ = 0;
+}
+
+void OverdrawMap::SetClip(int left, int top, int right, int bottom) {
+    clipped_ = true;
+    clip_[0] = left; clip_[1] = top; clip_[2] = right; clip_[3] = bottom;
+}
+
+void OverdrawMap::ClearClip() {
+    clipped_ = false;
+}
+
+void OverdrawMap::AddRect(int left, int top, int right, int bottom) {
+    ++ops_;
+    int l = std::max(left, 0), t = std::max(top, 0);
+    int r = std::min(right, width_), b = std::min(bottom, height_);
+    if (clipped_) {
+        l = std::max(l, clip_[0]); t = std::max(t, clip_[1]);
+        r = std::min(r, clip_[2]); b = std::min(b, clip_[3]);
+    }
+    if (l >= r || t >= b) return; // fuera del frame o del clip (y frame de 0 px)
+    for (int y = t; y < b; ++y) {
+        std::uint16_t* row = &counts_[(std::size_t)y * width_];
+        for (int x = l; x < r; ++x)
+            if (row[x] != 0xFFFF) ++row[x];
+    }
+}
+
+OverdrawMap::Stats OverdrawMap::ComputeStats() const {
+    Stats s;
+    s.ops = ops_;
+    for (std::uint16_t c : counts_) {
+        if (!c) continue;
+        ++s.touched;
+        s.painted += c;
+        if (c > s.max) s.max = c;
+    }
+    s.average = s.touched ? (double)s.painted / s.touched : 0.0;
+    return s;
+}
+
+std::wstring OverdrawMap::Summary(const wchar_t* cause, int dpi) const {
+    Stats st = ComputeStats();
+    double total = (double)width_ * height_;
+    wchar_t buf[200];
+    std::swprintf(buf, sizeof(buf) / sizeof(buf[0]),
+        L"[Overdraw] %ls %dx%d @%d dpi: tocados %llu (%.1f%%), promedio %.2f, max %u, ops %llu\n",
+        cause, width_, height_, dpi, (unsigned long long)st.touched,
+        total > 0 ? st.touched * 100.0 / total : 0.0, st.average, st.max, (unsigned long long)st.ops);
+    return buf;
+}
+
+std::uint32_t OverdrawMap::HeatColor(std::uint32_t count) {
+    static const std::uint32_t kRamp[] = {
+        0x000000, // sin pintar
+        0x2060FF, // 1: azul
+        0x20C060, // 2: verde
+        0xFFE020, // 3: amarillo
+        0xFF8000, // 4: naranja
+        0xFF2020, // 5+: rojo
+    };
+    const std::uint32_t last = sizeof(kRamp) / sizeof(kRamp[0]) - 1;
+    return kRamp[count < last ? count : last];
+}
+
+void OverdrawMap::BlendHeatmap(std::uint32_t* pixels, int stride, std::uint8_t alpha) const {
+    const std::uint32_t a = alpha, na = 255 - alpha;
+    for (int y = 0; y < height_; ++y) {
+        std::uint32_t* row = pixels + (std::size_t)y * stride;
+        const std::uint16_t* counts = &counts_[(std::size_t)y * width_];
+        for (int x = 0; x < width_; ++x) {
+            if (!counts[x]) continue;
+            std::uint32_t src = row[x], heat = HeatColor(counts[x]);
+            std::uint32_t out = 0;
+            for (int shift = 0; shift <= 16; shift += 8) {
+                std::uint32_t c = (((src >> shift) & 0xFF) * na + ((heat >> shift) & 0xFF) * a) / 255;
+                out |= c << shift;
+            }
+            row[x] = out;
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Contador de sobre-pintado por pxel para depuracin: cada operacin de dibujo
+// suma 1 en los pxeles que cubre (recortados al clip activo). No depende de Win32.
+class OverdrawMap {
+public:
+    struct Stats {
+        std::uint64_t ops = 0;      // operaciones de dibujo registradas
+        std::uint64_t touched = 0;  // pxeles pintados al menos una vez
+        std::uint64_t painted = 0;  // suma de todos los contadores
+        std::uint32_t max = 0;      // pxel ms pintado
+        double average = 0.0;       // painted / touched
+    };
+
+    // Empieza un frame nuevo
+    void Reset(int width, int height);
+
+    void SetClip(int left, int top, int right, int bottom);
+    void ClearClip();
+
+    // Rect semiabierto [left, right) x [top, bottom)
+    void AddRect(int left, int top, int right, int bottom);
+
+    Stats ComputeStats() const;
+
+    // Una lnea por frame: qu lo pidi, cuntos pxeles toc y cuntas veces.
+    // La escriben F2 y el modo headless en Windows y overdraw_frames en Linux.
+    std::wstring Summary(const wchar_t* cause, int dpi) const;
+    std::uint32_t At(int x, int y) const { return counts_[(std::size_t)y * width_ + x]; }
+    int Width() const { return width_; }
+    int Height() const { return height_; }
+
+    // Color del heatmap para un contador (0x00RRGGBB): azul = 1 ... rojo = 5 o ms
+    static std::uint32_t HeatColor(std::uint32_t count);
+
+    // Mezcla el heatmap sobre pxeles 0x00RRGGBB (fila 0 arriba); stride en pxeles
+    void BlendHeatmap(std::uint32_t* pixels, int stride, std::uint8_t alpha) const;
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<std::uint16_t> counts_;
+    bool clipped_ = false;
+    int clip_[4] = { 0, 0, 0, 0 };
+    std::uint64_t ops_ = 0;
+};
@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Estado de la UI que necesita el hilo de render. No depende de Win32 para que
+// se pueda compilar y probar en cualquier plataforma.
+
+enum Section { SEC_INICIO, SEC_CARTA, SEC_HISTORIA, SEC_HORARIOS, SEC_CONTACTO };
+enum Plato { PLATO_NONE, PLATO_RANAS, PLATO_CARACOLES, PLATO_RABAS, PLATO_MERLUZA, PLATO_GAMBAS };
+enum Especial { ESP_NONE, ESP_QUINOTOS, ESP_MONDONGO, ESP_RINONES, ESP_CALAMARETTIS };
+
+// Foto inmutable de lo que hay que pintar. El hilo de UI arma una nueva por cada
+// cambio y nunca la modifica despus de publicarla.
+struct UiSnapshot {
+    std::uint32_t seq = 0;       // creciente, para detectar estados viejos
+    Section section = SEC_INICIO;
+    Plato plato = PLATO_RANAS;
+    Especial especial = ESP_QUINOTOS;
+    int scrollPos = 0;           // pxeles
+    int width = 0;               // rea cliente
+    int height = 0;
+    int dpi = 96;
+    bool liveResize = false;     // entre WM_ENTERSIZEMOVE y WM_EXITSIZEMOVE
+    bool fastScroll = false;     // eventos de scroll muy seguidos
+    std::wstring busqueda;       // texto tipeado en la Carta
+    std::vector<int> platos;     // ndices visibles de kPlatos segn la bsqueda
+    std::vector<int> especiales; // ndices visibles de kEspeciales
+    bool overdraw = false;       // modo debug de sobre-pintado (F2)
+    const wchar_t* cause = L"";  // evento que pidi el frame (literal esttico)
+};
+
+// Buzn de una sola posicin y sin locks. Un productor publica el estado ms
+// reciente; el consumidor toma siempre el ltimo y los intermedios se descartan.
+template <typename T>
+class Mailbox {
+public:
+    Mailbox() = default;
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+    ~Mailbox() { delete slot_.load(std::memory_order_acquire); }
+
+    // Devuelve true si reemplaz un valor que nadie lleg a tomar
+    bool Publish(std::unique_ptr<const T> value) {
+        const T* old = slot_.exchange(value.release(), std::memory_order_acq_rel);
+        delete old;
+        return old != nullptr;
+    }
+
+    // Toma el ltimo valor publicado (nullptr si no hay nada nuevo)
+    std::unique_ptr<const T> Take() {
+        return std::unique_ptr<const T>(slot_.exchange(nullptr, std::memory_order_acq_rel));
+    }
+
+private:
+    std::atomic<const T*> slot_{ nullptr };
+};
+
+// Decide si los rects del ltimo layout aplicado sirven para el hit-testing.
+// Solo lo usa el hilo de UI: numera cada snapshot y recuerda el primero cuya
+// forma de layout cambi. Un layout anterior a ese cambio se descarta y, hasta
+// que llegue uno nuevo, los clicks sobre la lista se ignoran.
+class LayoutGate {
+public:
+    void Stamp(UiSnapshot& snap) {
+        snap.seq = ++seq_;
+        if (!SameLayout(snap, last_)) changed_ = snap.seq;
+        last_.section = snap.section;
+        last_.width = snap.width;
+        last_.height = snap.height;
+        last_.dpi = snap.dpi;
+        last_.platos = snap.platos;
+        last_.especiales = snap.especiales;
+    }
+
+    // true si el layout del snapshot 'seq' se puede aplicar
+    bool Accept(std::uint32_t seq) {
+        if (seq < changed_) return false;
+        applied_ = seq;
+        return true;
+    }
+
+    // true si los rects aplicados tienen la forma del ltimo estado publicado
+    bool Current() const { return applied_ >= changed_; }
+
+    // Misma forma = mismos rects salvo el scroll, que el hit-testing corrige
+    // aparte. El plato o la especialidad elegidos solo cambian colores.
+    static bool SameLayout(const UiSnapshot& a, const UiSnapshot& b) {
+        return a.section == b.section && a.width == b.width && a.height == b.height
+            && a.dpi == b.dpi && a.platos == b.platos && a.especiales == b.especiales;
+    }
+
+private:
+    std::uint32_t seq_ = 0;      // ltimo seq publicado
+    std::uint32_t changed_ = 0;  // primer seq con la forma actual
+    std::uint32_t applied_ = 0;  // seq del layout aplicado
+    UiSnapshot last_;            // solo los campos que definen la forma
+};
@@ -1,4 +1,7 @@
 #include "ui.h"
+#include <shellapi.h>
+
+#pragma comment(lib, "Shell32.lib")
 
 int APIENTRY wWinMain(HINSTANCE hInst, HINSTANCE, LPWSTR, int nCmd) {
 #if DPI_AWARE
@@ -6,6 +9,19 @@ int APIENTRY wWinMain(HINSTANCE hInst, HINSTANCE, LPWSTR, int nCmd) {
     SetProcessDpiAwarenessContext(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
 #endif
 
+    // Estadsticas de sobre-pintado sin ventana, para corridas automticas:
+    //   Tarea_3_PGE.exe --overdraw-headless "C:\salida\overdraw.txt"
+    int argc = 0;
+    if (LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc)) {
+        for (int i = 1; i < argc; ++i) {
+            if (wcscmp(argv[i], L"--overdraw-headless") != 0) continue;
+            bool ok = RunOverdrawHeadless(i + 1 < argc ? argv[i + 1] : L"overdraw.txt");
+            LocalFree(argv);
+            return ok ? 0 : 1;
+        }
+        LocalFree(argv);
+    }
+
     RegisterChichiloWindow(hInst);
 
     HWND hWnd = CreateWindowExW(
@@ -5,7 +5,21 @@
 #include <tchar.h>
 #include <string>
 #include <vector>
+#include <list>
+#include <map>
+#include <tuple>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <atomic>
+#include <memory>
 #include "Resource.h"
+#include "RenderState.h"
+#include "MenuSearch.h"
+#include "DibView.h"
+#include "Overdraw.h"
+#include "Canvas.h"
+#include "Frame.h"
 
 #pragma comment(lib, "Dwmapi.lib")
 #pragma comment(lib, "UxTheme.lib")
@@ -13,40 +27,30 @@
 // -------------------- Globals --------------------
 const wchar_t* kAppClass = L"ChichiloWin32App";
 
-static int g_dpi = 96; // 96 = 100%
+// 96 = 100%. Cada hilo tiene el suyo: el de UI para hit-testing y scroll,
+// el de render el del set de recursos activo.
+static thread_local int g_dpi = 96;
 static HFONT g_hFontTitle = nullptr;
 static HFONT g_hFontText = nullptr;
 static HFONT g_hFontSmall = nullptr;
 
-enum Section { SEC_INICIO, SEC_CARTA, SEC_HISTORIA, SEC_HORARIOS, SEC_CONTACTO };
 static Section g_section = SEC_INICIO;
 
-enum Plato { PLATO_NONE, PLATO_RANAS, PLATO_CARACOLES, PLATO_RABAS, PLATO_MERLUZA, PLATO_GAMBAS };
-struct PlatoDef { Plato id; const wchar_t* nombre; int recurso; };
-
-static const PlatoDef kPlatos[] = {
-    { PLATO_RANAS,     L"Ranas a la provenzal",      IDB_RANAS },
-    { PLATO_CARACOLES, L"Caracoles a la Bordaleza",  IDB_CARACOLES },
-    { PLATO_RABAS,     L"Rabas a la Calabria",       IDB_RABAS },
-    { PLATO_MERLUZA,   L"Merluza al ajillo",         IDB_MERLUZA },
-    { PLATO_GAMBAS,    L"Gambas al Ajillo",          IDB_GAMBAS },
-};
-
 static Plato g_platoSeleccionado = PLATO_RANAS;
-static std::vector<RECT> g_platoRects; // mismos ndices que kPlatos
+static std::vector<Rect> g_platoRects; // mismos ndices que kPlatos
 
 // ---- Especialidades ----
-enum Especial { ESP_NONE, ESP_QUINOTOS, ESP_MONDONGO, ESP_RINONES, ESP_CALAMARETTIS };
-struct EspDef { Especial id; const wchar_t* nombre; int recurso; };
-
-static const EspDef kEspeciales[] = {
-    { ESP_QUINOTOS,     L"Quinotos al Rhum con Helado de Americana", IDB_QUINTOS },
-    { ESP_MONDONGO,     L"Mondongo a la Italiana",                    IDB_MONDONGO },
-    { ESP_RINONES,      L"Riones al Vino Blanco",                    IDB_RINONES },
-    { ESP_CALAMARETTIS, L"Calamarettis a la Escarpetta",              IDB_CALAMARETTIS },
-};
 static Especial g_especialSeleccionada = ESP_QUINOTOS;
-static std::vector<RECT> g_especialRects; // mismos ndices que kEspeciales
+static std::vector<Rect> g_especialRects; // mismos ndices que kEspeciales
+
+// ---- Bsqueda en la Carta ----
+// Un solo ndice para las dos listas: ids [0, N platos) = kPlatos, el resto = kEspeciales
+static MenuSearch g_menuIndex;
+static std::wstring g_busqueda;
+static std::vector<int> g_platosVisibles;
+static std::vector<int> g_especialesVisibles;
+static std::vector<int> g_platoIndex;    // kPlatos[] de cada rect de g_platoRects
+static std::vector<int> g_especialIndex; // kEspeciales[] de cada rect de g_especialRects
 
 // Scroll (ahora para TODAS las secciones)
 static int g_vscrollPos = 0;      // pxeles
@@ -54,8 +58,22 @@ static int g_vscrollMax = 0;      // p
 static int g_viewportH = 0;       // alto visible del "card"
 static int g_contentH = 0;       // alto total del contenido dentro del card
 
-static const int kHeaderHeight = 140;
-static const int kSectionBarHeight = 48;
+// -------------------- Hilo de render --------------------
+// El hilo de UI solo arma un UiSnapshot y lo publica; el hilo de render toma
+// siempre el ltimo, pinta y presenta. El layout vuelve por otro buzn.
+static const UINT WM_APP_LAYOUT = WM_APP + 1;
+static Mailbox<UiSnapshot> g_snapshots;
+static Mailbox<LayoutResult> g_layouts;
+static std::thread g_renderThread;
+static HANDLE g_renderWake = nullptr;     // evento auto-reset
+static std::atomic<bool> g_renderQuit{ false };
+static int g_layoutScroll = 0;            // scroll con el que se calcularon los rects
+static LayoutGate g_layoutGate;           // seq de snapshots y layouts (hilo de UI)
+
+// Entrada (hilo de UI), para el gobernador de calidad
+static bool g_liveResize = false;
+static ULONGLONG g_prevScroll = 0;        // ms (GetTickCount64) de los dos ltimos scrolls
+static ULONGLONG g_lastScroll = 0;
 
 // -------------------- Utilidades --------------------
 inline int S(int px) { return MulDiv(px, g_dpi, 96); }
@@ -69,18 +87,191 @@ HFONT MakeFont(int pts, int weight = FW_NORMAL, bool italic = false) {
     return CreateFontIndirectW(&lf);
 }
 
-void InitFonts() {
-    if (!g_hFontTitle) g_hFontTitle = MakeFont(24, FW_SEMIBOLD);
-    if (!g_hFontText)  g_hFontText = MakeFont(11);
-    if (!g_hFontSmall) g_hFontSmall = MakeFont(9);
+// -------------------- Recursos por DPI --------------------
+// Cada DPI visitado conserva sus fuentes, imgenes escaladas, la capa del header
+// y las alturas de prrafo ya medidas. Volver a un DPI conocido es cambiar g_res.
+struct ScaledImage {
+    int resId = 0;
+    int dstW = 0, dstH = 0;   // rect destino para el que se escal
+    int srcW = 0, srcH = 0;   // tamao original del recurso
+    int w = 0, h = 0;         // tamao final (manteniendo aspecto)
+    HBITMAP bmp = nullptr;
+    bool provisional = false; // copiada de otro DPI, falta la versin HALFTONE
+};
+
+// Altura de un prrafo ya medida. Se busca por hash del texto para no copiarlo
+// en cada consulta; el texto se guarda solo para descartar colisiones.
+struct TextHeight {
+    HFONT font = nullptr;
+    int w = 0;
+    size_t hash = 0;
+    std::wstring text;
+    int height = 0;
+};
+typedef std::tuple<HFONT, int, size_t> TextHeightKey;
+
+struct DpiResources {
+    int dpi = 96;
+    HFONT fontTitle = nullptr;
+    HFONT fontText = nullptr;
+    HFONT fontSmall = nullptr;
+    std::vector<ScaledImage> images; // una entrada por recurso
+    HBITMAP header = nullptr;        // capa del header ya pintada
+    int headerW = 0;
+    std::list<TextHeight> textHeights; // LRU: front = ms reciente
+    std::map<TextHeightKey, std::list<TextHeight>::iterator> textIndex;
+};
+
+static const size_t kMaxDpiSets = 3;        // LRU: se descarta el menos usado
+static const size_t kMaxTextHeights = 256;  // tope de alturas medidas por set (LRU)
+static std::list<DpiResources> g_dpiSets;   // front = ms reciente
+static DpiResources* g_res = nullptr;        // set activo
+
+// Medicin de transiciones de DPI (se reporta al terminar el primer frame)
+static const DWORD kRefineDelayMs = 50;
+static bool g_dpiTransition = false;
+static bool g_dpiTransitionHit = false;
+static int g_dpiFrom = 96;
+static std::atomic<LONGLONG> g_dpiChangeStart{ 0 }; // lo escribe el hilo de UI
+static bool g_hasProvisional = false;
+
+static void FreeDpiResources(DpiResources& r) {
+    if (r.fontTitle) DeleteObject(r.fontTitle);
+    if (r.fontText) DeleteObject(r.fontText);
+    if (r.fontSmall) DeleteObject(r.fontSmall);
+    for (auto& img : r.images) if (img.bmp) DeleteObject(img.bmp);
+    if (r.header) DeleteObject(r.header);
+    r = DpiResources{};
+}
+
+// Activa el set del DPI pedido, crendolo si hace falta. Devuelve true si ya exista.
+static bool ActivateDpi(int dpi) {
+    g_dpi = dpi;
+    bool hit = false;
+    for (auto it = g_dpiSets.begin(); it != g_dpiSets.end(); ++it) {
+        if (it->dpi == dpi) {
+            g_dpiSets.splice(g_dpiSets.begin(), g_dpiSets, it);
+            hit = true;
+            break;
+        }
+    }
+    if (!hit) {
+        g_dpiSets.emplace_front();
+        DpiResources& r = g_dpiSets.front();
+        r.dpi = dpi;
+        r.fontTitle = MakeFont(24, FW_SEMIBOLD);
+        r.fontText = MakeFont(11);
+        r.fontSmall = MakeFont(9);
+        while (g_dpiSets.size() > kMaxDpiSets) {
+            FreeDpiResources(g_dpiSets.back());
+            g_dpiSets.pop_back();
+        }
+    }
+    g_res = &g_dpiSets.front();
+    g_hFontTitle = g_res->fontTitle;
+    g_hFontText = g_res->fontText;
+    g_hFontSmall = g_res->fontSmall;
+    return hit;
+}
+
+static void DestroyDpiSets() {
+    for (auto& r : g_dpiSets) FreeDpiResources(r);
+    g_dpiSets.clear();
+    g_res = nullptr;
+    g_hFontTitle = g_hFontText = g_hFontSmall = nullptr;
+}
+
+// -------------------- Calidad adaptativa --------------------
+// Durante un resize interactivo o un scroll rpido, si el ltimo frame completo
+// se pas del presupuesto se pasa a modo rpido: la capa del header se extiende
+// en vez de repintarse, el back buffer solo se reserva cuando crece y las
+// imgenes sin escalar usan COLORONCOLOR. Cada QUALITY_PROBE_MS se intenta un
+// frame completo para volver a medirlo; cuando la entrada se calma se agenda un
+// nico frame de calidad completa.
+enum RenderQuality { QUALITY_FULL, QUALITY_FAST };
+
+struct QualityGovernor {
+    double lastFullMs = 0.0;    // duracin del ltimo frame en calidad completa
+    double lastFastMs = 0.0;    // duracin del ltimo frame en modo rpido
+    ULONGLONG lastFullAt = 0;   // GetTickCount64 del ltimo frame completo
+    bool forceFull = false;     // la entrada se calm: el prximo frame es completo
+    RenderQuality quality = QUALITY_FULL;
+};
+static QualityGovernor g_gov;  // solo lo toca el hilo de render
+
+static void NoteScroll() {
+    g_prevScroll = g_lastScroll;
+    g_lastScroll = GetTickCount64();
+}
+
+static bool IsFastScrolling() {
+    if (g_prevScroll == 0) return false;
+    ULONGLONG now = GetTickCount64();
+    return g_lastScroll - g_prevScroll <= QUALITY_FAST_SCROLL_MS
+        && now - g_lastScroll <= QUALITY_SETTLE_MS;
+}
+
+// Decide la calidad del frame que est por pintarse. Solo se loguea cuando la
+// calidad cambia, no en cada frame (ver QUALITY_* en Ui.h).
+static void ChooseQuality(const UiSnapshot& s) {
+    RenderQuality q = QUALITY_FULL;
+    const wchar_t* why = L"entrada en calma";
+    bool interactive = s.liveResize || s.fastScroll;
+
+    if (g_gov.forceFull) {
+        g_gov.forceFull = false;
+        why = L"frame final";
+    }
+    else if (QUALITY_POLICY != 0 && interactive) {
+        if (g_gov.lastFullMs <= QUALITY_FRAME_BUDGET_MS) why = L"dentro del presupuesto";
+        else if (GetTickCount64() - g_gov.lastFullAt >= QUALITY_PROBE_MS) why = L"sondeo";
+        else {
+            q = QUALITY_FAST;
+            why = s.liveResize ? L"resize" : L"scroll";
+        }
+    }
+
+    if (q != g_gov.quality) {
+        wchar_t buf[200];
+        swprintf_s(buf, L"[Calidad] %s (%s): ltimo frame completo %.2f ms, ltimo rpido %.2f ms, presupuesto %d ms\n",
+            q == QUALITY_FAST ? L"rpida" : L"completa", why, g_gov.lastFullMs, g_gov.lastFastMs,
+            QUALITY_FRAME_BUDGET_MS);
+        OutputDebugStringW(buf);
+    }
+    g_gov.quality = q;
+}
+
+// Guarda la duracin del frame segn su calidad. ChooseQuality compara la del
+// ltimo completo con el presupuesto; la del rpido solo va al log. La espera de
+// QUALITY_SETTLE_MS y el frame final estn en RenderThreadProc.
+static void EndFrame(double ms) {
+    if (g_gov.quality == QUALITY_FULL) {
+        g_gov.lastFullMs = ms;
+        g_gov.lastFullAt = GetTickCount64();
+    }
+    else g_gov.lastFastMs = ms;
 }
 
-void DeleteFonts() {
-    if (g_hFontTitle) { DeleteObject(g_hFontTitle); g_hFontTitle = nullptr; }
-    if (g_hFontText) { DeleteObject(g_hFontText);  g_hFontText = nullptr; }
-    if (g_hFontSmall) { DeleteObject(g_hFontSmall); g_hFontSmall = nullptr; }
+static void ReportDpiTransition() {
+    LARGE_INTEGER now, freq;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&freq);
+    double ms = (now.QuadPart - g_dpiChangeStart.load()) * 1000.0 / freq.QuadPart;
+    wchar_t buf[128];
+    swprintf_s(buf, L"[DPI] %d -> %d: %.2f ms (%s)\n", g_dpiFrom, g_dpi, ms,
+        g_dpiTransitionHit ? L"set en cache" : L"set nuevo");
+    OutputDebugStringW(buf);
 }
 
+// -------------------- Sobre-pintado (debug) --------------------
+// Con F2 el frame se pinta a travs de un CountingCanvas que suma cada operacin
+// en un OverdrawMap; el frame se presenta con el heatmap encima y las
+// estadsticas van a OutputDebugStringW. La capa del header se pinta con sus
+// operaciones reales en vez de copiarse de la cach.
+static OverdrawMap g_overdraw;         // hilo de render (o modo headless)
+static bool g_overdrawOn = false;      // hilo de UI, se alterna con F2
+static const BYTE kHeatmapAlpha = 140;
+
 void DrawTextLine(HDC hdc, HFONT font, COLORREF color, int x, int y, const std::wstring& s) {
     HFONT old = (HFONT)SelectObject(hdc, font);
     SetTextColor(hdc, color);
@@ -89,42 +280,38 @@ void DrawTextLine(HDC hdc, HFONT font, COLORREF color, int x, int y, const std::
     SelectObject(hdc, old);
 }
 
-// Medir la altura real de un prrafo con word-wrap
+// Medir la altura real de un prrafo con word-wrap (cacheada en el set del DPI)
 static int MeasureParagraphHeight(HDC hdc, HFONT font, int w, const std::wstring& text) {
+    auto& lru = g_res->textHeights;
+    TextHeightKey key(font, w, std::hash<std::wstring>()(text));
+    auto found = g_res->textIndex.find(key);
+    if (found != g_res->textIndex.end() && found->second->text == text) {
+        lru.splice(lru.begin(), lru, found->second);
+        return found->second->height;
+    }
+
     RECT r{ 0,0,w,0 };
     HFONT old = (HFONT)SelectObject(hdc, font);
     DrawTextW(hdc, text.c_str(), (int)text.size(), &r,
         DT_LEFT | DT_TOP | DT_WORDBREAK | DT_CALCRECT);
     SelectObject(hdc, old);
-    return r.bottom - r.top;
-}
-
-// -------------------- Tabs --------------------
-struct TabDef { Section id; const wchar_t* label; };
-static const TabDef kTabs[] = {
-    {SEC_INICIO,   L"Inicio"},
-    {SEC_CARTA,    L"Carta"},
-    {SEC_HISTORIA, L"Historia"},
-    {SEC_HORARIOS, L"Horarios"},
-    {SEC_CONTACTO, L"Contacto"},
-};
-
-RECT SectionBarRect(RECT rcClient) {
-    RECT r = rcClient;
-    r.top += S(kHeaderHeight);
-    r.bottom = r.top + S(kSectionBarHeight);
-    return r;
-}
-
-std::vector<RECT> BuildTabRects(const RECT& bar) {
-    int count = (int)(sizeof(kTabs) / sizeof(kTabs[0]));
-    int w = (bar.right - bar.left) / count;
-    std::vector<RECT> out; out.reserve(count);
-    for (int i = 0; i < count; i++) {
-        RECT r{ bar.left + i * w, bar.top, bar.left + (i + 1) * w, bar.bottom };
-        out.push_back(r);
+    int height = r.bottom - r.top;
+
+    if (found != g_res->textIndex.end()) {
+        // Colisin de hash: la entrada pasa a ser la del texto nuevo
+        found->second->text = text;
+        found->second->height = height;
+        lru.splice(lru.begin(), lru, found->second);
+        return height;
+    }
+    if (lru.size() >= kMaxTextHeights) {
+        const TextHeight& oldest = lru.back();
+        g_res->textIndex.erase(TextHeightKey(oldest.font, oldest.w, oldest.hash));
+        lru.pop_back();
     }
-    return out;
+    lru.push_front(TextHeight{ font, w, std::get<2>(key), text, height });
+    g_res->textIndex.emplace(key, lru.begin());
+    return height;
 }
 
 void FillRectColor(HDC hdc, const RECT& r, COLORREF c) {
@@ -138,11 +325,35 @@ void DrawRoundedRect(HDC hdc, const RECT& r, int radius, COLORREF fill, COLORREF
     HPEN hPen = CreatePen(PS_SOLID, 1, border);
     HGDIOBJ oldB = SelectObject(hdc, hBrush);
     HGDIOBJ oldP = SelectObject(hdc, hPen);
-    RoundRect(hdc, r.left, r.top, r.right, r.bottom, S(radius), S(radius));
+    RoundRect(hdc, r.left, r.top, r.right, r.bottom, radius, radius);
     SelectObject(hdc, oldB); SelectObject(hdc, oldP);
     DeleteObject(hBrush); DeleteObject(hPen);
 }
 
+// -------------------- Bsqueda --------------------
+static void UpdateCartaFilter() {
+    const int nPlatos = (int)(sizeof(kPlatos) / sizeof(kPlatos[0]));
+    g_platosVisibles.clear();
+    g_especialesVisibles.clear();
+    for (std::uint32_t id : g_menuIndex.Search(g_busqueda)) {
+        if ((int)id < nPlatos) g_platosVisibles.push_back((int)id);
+        else g_especialesVisibles.push_back((int)id - nPlatos);
+    }
+
+    // Una seleccin que el filtro esconde deja de mostrar su imagen
+    bool platoVisible = false, especialVisible = false;
+    for (int i : g_platosVisibles) platoVisible |= kPlatos[i].id == g_platoSeleccionado;
+    for (int i : g_especialesVisibles) especialVisible |= kEspeciales[i].id == g_especialSeleccionada;
+    if (!platoVisible) g_platoSeleccionado = PLATO_NONE;
+    if (!especialVisible) g_especialSeleccionada = ESP_NONE;
+}
+
+static void BuildMenuIndex() {
+    for (const auto& p : kPlatos) g_menuIndex.Add(p.nombre);
+    for (const auto& e : kEspeciales) g_menuIndex.Add(e.nombre);
+    UpdateCartaFilter();
+}
+
 // -------------------- Scroll helpers --------------------
 static void EnsureVScrollStyle(HWND hWnd, bool enable) {
     LONG_PTR style = GetWindowLongPtrW(hWnd, GWL_STYLE);
@@ -176,45 +387,6 @@ static void ApplyScrollBar(HWND hWnd) {
 }
 
 // -------------------- Pintado --------------------
-void PaintHeader(HDC hdc, const RECT& rcClient) {
-    RECT r{ rcClient.left, rcClient.top, rcClient.right, rcClient.top + S(kHeaderHeight) };
-
-    int h = r.bottom - r.top;
-    for (int i = 0; i < h; i++) {
-        BYTE g = (BYTE)(220 - (i * 120) / max(1, h));
-        HPEN p = CreatePen(PS_SOLID, 1, RGB(245, g, 120));
-        HGDIOBJ old = SelectObject(hdc, p);
-        MoveToEx(hdc, r.left, r.top + i, nullptr);
-        LineTo(hdc, r.right, r.top + i);
-        SelectObject(hdc, old);
-        DeleteObject(p);
-    }
-
-    DrawTextLine(hdc, g_hFontTitle, RGB(40, 40, 40), S(24), r.top + S(26), L"Cantina Chichilo");
-    DrawTextLine(hdc, g_hFontText, RGB(60, 60, 60), S(26), r.top + S(66), L"Una familia para servirlo desde 1956");
-}
-
-void PaintSectionBar(HDC hdc, const RECT& rcClient) {
-    RECT bar = SectionBarRect(rcClient);
-    FillRectColor(hdc, bar, RGB(250, 246, 240));
-    auto rects = BuildTabRects(bar);
-    for (size_t i = 0; i < rects.size(); ++i) {
-        const auto& t = kTabs[i];
-        RECT r = rects[i];
-        bool active = (g_section == t.id);
-        if (active) {
-            RECT rr = r; InflateRect(&rr, -S(8), -S(8));
-            DrawRoundedRect(hdc, rr, 12, RGB(255, 255, 255), RGB(230, 180, 120));
-        }
-        SIZE sz{}; HGDIOBJ old = SelectObject(hdc, g_hFontText);
-        GetTextExtentPoint32W(hdc, t.label, (int)wcslen(t.label), &sz);
-        SelectObject(hdc, old);
-        int cx = (r.left + r.right - sz.cx) / 2;
-        int cy = (r.top + r.bottom - sz.cy) / 2;
-        DrawTextLine(hdc, g_hFontText, RGB(60, 50, 40), cx, cy, t.label);
-    }
-}
-
 void DrawParagraph(HDC hdc, int x, int y, int w, const std::wstring& text) {
     RECT r{ x, y, x + w, y + S(2000) };
     HFONT old = (HFONT)SelectObject(hdc, g_hFontText);
@@ -224,312 +396,446 @@ void DrawParagraph(HDC hdc, int x, int y, int w, const std::wstring& text) {
     SelectObject(hdc, old);
 }
 
-// rea de contenido (card) coherente para pintar y para hit-testing
-static RECT GetContentCardRect(const RECT& rcClient) {
-    RECT bar = SectionBarRect(rcClient);
-    RECT content{ rcClient.left + S(24), bar.bottom + S(20), rcClient.right - S(24), rcClient.bottom - S(24) };
-    RECT card = content; InflateRect(&card, -S(4), -S(4));
-    return card;
+// Vista de solo lectura sobre el DIB del recurso, ya mapeado junto con el
+// ejecutable: se escala con StretchDIBits sin pasar por un DDB intermedio
+static bool LoadDibResource(int resId, DibView& out) {
+    HMODULE mod = GetModuleHandle(nullptr);
+    HRSRC res = FindResourceW(mod, MAKEINTRESOURCEW(resId), RT_BITMAP);
+    if (!res) return false;
+    HGLOBAL h = LoadResource(mod, res);
+    const void* data = h ? LockResource(h) : nullptr;
+    return data && ParsePackedDib(data, SizeofResource(mod, res), out);
 }
 
-// Dibuja BMP dentro de un rect, manteniendo aspecto
-static void DrawBitmapFromResourceFitRect(HDC hdc, const RECT& dest, int resId) {
-    HBITMAP hBmp = LoadBitmap(GetModuleHandle(nullptr), MAKEINTRESOURCE(resId));
-    if (!hBmp) return;
-    BITMAP bm; GetObject(hBmp, sizeof(bm), &bm);
+// Imagen ya escalada de otro set (el DPI ms cercano) para el primer frame tras un cambio
+static const ScaledImage* FindNearestScaled(int resId) {
+    const ScaledImage* best = nullptr;
+    int bestDiff = 0;
+    for (const auto& set : g_dpiSets) {
+        if (&set == g_res) continue;
+        for (const auto& img : set.images) {
+            if (img.resId != resId || img.provisional) continue;
+            int diff = abs(set.dpi - g_dpi);
+            if (!best || diff < bestDiff) { best = &img; bestDiff = diff; }
+        }
+    }
+    return best;
+}
 
-    HDC mem = CreateCompatibleDC(hdc);
-    HGDIOBJ old = SelectObject(mem, hBmp);
+// Escala el recurso al rect destino y lo guarda en el set activo (una entrada por recurso)
+static const ScaledImage* BuildScaledImage(HDC hdc, int resId, int dstW, int dstH) {
+    ScaledImage img;
+    img.resId = resId;
+    img.dstW = dstW;
+    img.dstH = dstH;
+
+    // Tras un cambio de DPI se reutiliza la imagen del set ms cercano con un
+    // escalado barato; la versin HALFTONE se arma despus (kRefineDelayMs).
+    DibView dib;
+    const ScaledImage* nearest = g_dpiTransition ? FindNearestScaled(resId) : nullptr;
+    if (nearest) {
+        img.srcW = nearest->srcW; img.srcH = nearest->srcH;
+        img.provisional = true;
+    }
+    else {
+        if (!LoadDibResource(resId, dib)) return nullptr;
+        img.srcW = dib.width; img.srcH = dib.height;
+    }
+
+    double k = min((double)dstW / img.srcW, (double)dstH / img.srcH);
+    img.w = max(1, (int)(img.srcW * k));
+    img.h = max(1, (int)(img.srcH * k));
+    img.bmp = CreateCompatibleBitmap(hdc, img.w, img.h);
+
+    HDC dst = CreateCompatibleDC(hdc);
+    HGDIOBJ oldDst = SelectObject(dst, img.bmp);
+    if (nearest) {
+        HDC src = CreateCompatibleDC(hdc);
+        HGDIOBJ oldSrc = SelectObject(src, nearest->bmp);
+        SetStretchBltMode(dst, COLORONCOLOR);
+        StretchBlt(dst, 0, 0, img.w, img.h, src, 0, 0, nearest->w, nearest->h, SRCCOPY);
+        SelectObject(src, oldSrc);
+        DeleteDC(src);
+        g_hasProvisional = true;
+    }
+    else {
+        SetStretchBltMode(dst, HALFTONE);
+        SetBrushOrgEx(dst, 0, 0, nullptr);
+        StretchDIBits(dst, 0, 0, img.w, img.h, 0, 0, img.srcW, img.srcH,
+            dib.bits, (const BITMAPINFO*)dib.info, DIB_RGB_COLORS, SRCCOPY);
+    }
+    SelectObject(dst, oldDst);
+    DeleteDC(dst);
+
+    for (auto& e : g_res->images) {
+        if (e.resId == resId) {
+            if (e.bmp) DeleteObject(e.bmp);
+            e = img;
+            return &e;
+        }
+    }
+    g_res->images.push_back(img);
+    return &g_res->images.back();
+}
+
+// Escalado barato para frames rpidos: no toca la cach del set
+static Rect DrawBitmapFast(HDC hdc, const Rect& dest, int resId) {
+    const ScaledImage* last = nullptr;
+    if (QUALITY_POLICY == 1) {
+        for (const auto& e : g_res->images) {
+            if (e.resId == resId) { last = &e; break; }
+        }
+    }
+
+    DibView dib;
+    int fullW = 0, fullH = 0; // tamao original, para el aspecto
+    if (last) {
+        fullW = last->srcW; fullH = last->srcH;
+    }
+    else {
+        if (!LoadDibResource(resId, dib)) return Rect{};
+        fullW = dib.width; fullH = dib.height;
+    }
+
+    Rect r = FitImage(dest, fullW, fullH);
+    int x = r.left, y = r.top, w = r.right - r.left, h = r.bottom - r.top;
+
+    SetStretchBltMode(hdc, COLORONCOLOR);
+    if (last) {
+        HDC mem = CreateCompatibleDC(hdc);
+        HGDIOBJ old = SelectObject(mem, last->bmp);
+        StretchBlt(hdc, x, y, w, h, mem, 0, 0, last->w, last->h, SRCCOPY);
+        SelectObject(mem, old);
+        DeleteDC(mem);
+    }
+    else {
+        StretchDIBits(hdc, x, y, w, h, 0, 0, fullW, fullH,
+            dib.bits, (const BITMAPINFO*)dib.info, DIB_RGB_COLORS, SRCCOPY);
+    }
+    return r;
+}
 
+// Dibuja BMP dentro de un rect, manteniendo aspecto. Devuelve el rect pintado.
+static Rect DrawBitmapFromResourceFitRect(HDC hdc, const Rect& dest, int resId) {
     int dstW = dest.right - dest.left;
     int dstH = dest.bottom - dest.top;
+    if (dstW <= 0 || dstH <= 0) return Rect{};
 
-    double sx = (double)dstW / bm.bmWidth;
-    double sy = (double)dstH / bm.bmHeight;
-    double k = min(sx, sy);
-
-    int w = (int)(bm.bmWidth * k);
-    int h = (int)(bm.bmHeight * k);
-    int x = dest.left + (dstW - w) / 2;
-    int y = dest.top + (dstH - h) / 2;
+    const ScaledImage* img = nullptr;
+    for (const auto& e : g_res->images) {
+        if (e.resId == resId && e.dstW == dstW && e.dstH == dstH) { img = &e; break; }
+    }
+    if (!img && g_gov.quality == QUALITY_FAST) return DrawBitmapFast(hdc, dest, resId);
+    if (!img) img = BuildScaledImage(hdc, resId, dstW, dstH);
+    if (!img) return Rect{};
 
-    SetStretchBltMode(hdc, HALFTONE);
-    SetBrushOrgEx(hdc, 0, 0, nullptr);
-    StretchBlt(hdc, x, y, w, h, mem, 0, 0, bm.bmWidth, bm.bmHeight, SRCCOPY);
+    int x = dest.left + (dstW - img->w) / 2;
+    int y = dest.top + (dstH - img->h) / 2;
 
+    HDC mem = CreateCompatibleDC(hdc);
+    HGDIOBJ old = SelectObject(mem, img->bmp);
+    BitBlt(hdc, x, y, img->w, img->h, mem, 0, 0, SRCCOPY);
     SelectObject(mem, old);
     DeleteDC(mem);
-    DeleteObject(hBmp);
-}
-
-// -------------------- Contenido --------------------
-void PaintContent(HDC hdc, const RECT& rcClient) {
-    RECT card = GetContentCardRect(rcClient);
-
-    // Sombra + card
-    RECT shadow = card; OffsetRect(&shadow, S(3), S(3));
-    FillRectColor(hdc, shadow, RGB(230, 230, 230));
-    DrawRoundedRect(hdc, card, 16, RGB(255, 255, 255), RGB(235, 215, 190));
-
-    int pad = S(20);
-    int x = card.left + pad;
-    int y = card.top + pad;
-    int w = (card.right - card.left) - 2 * pad;
-
-    // Clip y offset de scroll SIEMPRE
-    RECT clip = card; InflateRect(&clip, -S(8), -S(8));
-    HRGN rgn = CreateRectRgn(clip.left, clip.top, clip.right, clip.bottom);
-    SelectClipRgn(hdc, rgn);
-    const int yOff = -g_vscrollPos;
-
-    // Inicializamos viewport y contenido
-    g_viewportH = card.bottom - card.top;
-    g_contentH = g_viewportH;
-
-    switch (g_section) {
-    case SEC_INICIO: {
-        int yCur = y;
-
-        // Ttulo
-        DrawTextLine(hdc, g_hFontTitle, RGB(30, 30, 30), x, yCur + yOff, L"Bienvenido a la Cantina");
-        yCur += S(40);
-
-        // ===== Columna derecha: FRENTE =====
-        const int rightColW = S(420);
-        const int imgH = S(320);
-
-        RECT imgRect{
-            card.right - pad - rightColW,
-            y + yOff,                // alineado arriba del contenido (como en Contacto)
-            card.right - pad,
-            y + imgH + yOff
-        };
-        DrawRoundedRect(hdc, imgRect, 12, RGB(255, 255, 255), RGB(235, 215, 190));
-        RECT imgInner = imgRect; InflateRect(&imgInner, -S(14), -S(14));
-        DrawBitmapFromResourceFitRect(hdc, imgInner, IDB_FRENTE);
-
-        // ===== Columna izquierda: texto =====
-        const int leftColW = w - (rightColW + S(20)); // deja un gap entre columnas
-        std::wstring p1 = L"Clsico bodegn porteo en La Paternal...";
-        DrawParagraph(hdc, x, yCur + yOff, leftColW, p1);
-        int h1 = MeasureParagraphHeight(hdc, g_hFontText, leftColW, p1);
-
-        // Alto lgico total = lo ms bajo entre texto e imagen
-        int logicalBottom = max(yCur + h1, (imgRect.bottom - yOff)) + S(20);
-        g_contentH = (logicalBottom - card.top) + S(10);
-    } break;
-
-    case SEC_CARTA: {
-        DrawTextLine(hdc, g_hFontTitle, RGB(30, 30, 30), x, y + yOff, L"Nuestra Carta");
-        int yAfterTitle = y + S(44);
-
-        // Columnas: izquierda = lista, derecha = imagen
-        const int leftColW = S(300);
-        const int buttonH = S(36);
-        const int buttonGap = S(12);
-
-        RECT imgRect{
-            card.right - pad - S(400),
-            card.top + pad + yOff,
-            card.right - pad,
-            card.top + pad + S(300) + yOff
-        };
-
-        // ---- Lista de PLATOS ----
-        g_platoRects.clear();
-        int yBtn = yAfterTitle;
-        for (const auto& p : kPlatos) {
-            RECT logical{ x, yBtn, x + leftColW, yBtn + buttonH };
-            RECT r = logical; OffsetRect(&r, 0, yOff);
-            g_platoRects.push_back(r);
-
-            COLORREF fondo = (g_platoSeleccionado == p.id) ? RGB(255, 245, 230) : RGB(255, 255, 255);
-            DrawRoundedRect(hdc, r, 8, fondo, RGB(210, 190, 160));
-            DrawTextLine(hdc, g_hFontText, RGB(30, 30, 30), r.left + S(12), r.top + (buttonH / 4), p.nombre);
-
-            yBtn += buttonH + buttonGap;
-        }
+    return Rect{ x, y, x + img->w, y + img->h };
+}
 
-        // Marco + imagen Platos
-        DrawRoundedRect(hdc, imgRect, 12, RGB(255, 255, 255), RGB(235, 215, 190));
-        for (const auto& p : kPlatos) {
-            if (p.id == g_platoSeleccionado) {
-                RECT inner = imgRect; InflateRect(&inner, -S(14), -S(14));
-                DrawBitmapFromResourceFitRect(hdc, inner, p.recurso);
-                break;
+// Descarta las imgenes provisionales para que el prximo frame las escale en
+// HALFTONE. Se limpian todos los sets: si el DPI cambi otra vez antes de la
+// pausa, el set anterior tambin qued con copias provisionales.
+static void RefineProvisionalImages() {
+    g_hasProvisional = false;
+    for (auto& set : g_dpiSets) {
+        auto& imgs = set.images;
+        for (size_t i = 0; i < imgs.size();) {
+            if (imgs[i].provisional) {
+                DeleteObject(imgs[i].bmp);
+                imgs.erase(imgs.begin() + i);
             }
+            else ++i;
         }
+    }
+}
 
-        // ---- ESPECIALIDADES ----
-        int yEspecialTitle = max(yBtn, (imgRect.bottom - yOff)) + S(36);
-        DrawTextLine(hdc, g_hFontTitle, RGB(30, 30, 30), x, yEspecialTitle + yOff, L"Nuestras Especialidades");
+// -------------------- Canvas GDI --------------------
+// PaintFrame (Frame.cpp) sobre un DC del hilo de render, con las fuentes y las
+// cachs del set de DPI activo
+static RECT ToRECT(const Rect& r) { return RECT{ r.left, r.top, r.right, r.bottom }; }
+static Rect FromRECT(const RECT& r) { return Rect{ (int)r.left, (int)r.top, (int)r.right, (int)r.bottom }; }
 
-        int yEspBtns = yEspecialTitle + S(44);
+static HFONT FontFor(FontId font) {
+    return font == FONT_TITLE ? g_hFontTitle : font == FONT_TEXT ? g_hFontText : g_hFontSmall;
+}
 
-        RECT imgRectEsp{
-            card.right - pad - S(400),
-            yEspecialTitle + yOff,
-            card.right - pad,
-            yEspecialTitle + S(280) + yOff
-        };
+class GdiCanvas : public Canvas {
+public:
+    explicit GdiCanvas(HDC hdc) : Canvas(g_dpi), hdc_(hdc) {}
 
-        g_especialRects.clear();
-        int yBtnEsp = yEspBtns;
-        for (const auto& e : kEspeciales) {
-            RECT logical{ x, yBtnEsp, x + leftColW, yBtnEsp + buttonH };
-            RECT r = logical; OffsetRect(&r, 0, yOff);
-            g_especialRects.push_back(r);
+    void Fill(const Rect& r, Color c) override { FillRectColor(hdc_, ToRECT(r), c); }
 
-            COLORREF fondo = (g_especialSeleccionada == e.id) ? RGB(255, 245, 230) : RGB(255, 255, 255);
-            DrawRoundedRect(hdc, r, 8, fondo, RGB(210, 190, 160));
-            DrawTextLine(hdc, g_hFontText, RGB(30, 30, 30), r.left + S(12), r.top + (buttonH / 4), e.nombre);
+    void Rounded(const Rect& r, int radius, Color fill, Color border) override {
+        DrawRoundedRect(hdc_, ToRECT(r), radius, fill, border);
+    }
 
-            yBtnEsp += buttonH + buttonGap;
-        }
+    void HLine(int left, int right, int y, Color c) override {
+        HPEN p = CreatePen(PS_SOLID, 1, c);
+        HGDIOBJ old = SelectObject(hdc_, p);
+        MoveToEx(hdc_, left, y, nullptr);
+        LineTo(hdc_, right, y);
+        SelectObject(hdc_, old);
+        DeleteObject(p);
+    }
 
-        // Marco + imagen Especialidad
-        DrawRoundedRect(hdc, imgRectEsp, 12, RGB(255, 255, 255), RGB(235, 215, 190));
-        for (const auto& e : kEspeciales) {
-            if (e.id == g_especialSeleccionada) {
-                RECT inner = imgRectEsp; InflateRect(&inner, -S(14), -S(14));
-                DrawBitmapFromResourceFitRect(hdc, inner, e.recurso);
-                break;
-            }
-        }
+    void Text(FontId font, Color c, int x, int y, const std::wstring& s) override {
+        DrawTextLine(hdc_, FontFor(font), c, x, y, s);
+    }
 
-        int logicalBottom = max(yBtnEsp, (imgRectEsp.bottom - yOff)) + S(20);
-        g_contentH = (logicalBottom - card.top) + S(10);
-    } break;
-
-    case SEC_HISTORIA: {
-        int yCur = y;
-        DrawTextLine(hdc, g_hFontTitle, RGB(30, 30, 30), x, yCur + yOff, L"Historia");
-        yCur += S(60);
-
-        int lastBottom = yCur;
-
-        std::wstring p1 = L"- Desde 1956, Cantina Chichilo es un cono de barrio...";
-        DrawParagraph(hdc, x, yCur + yOff, w, p1);
-        int h1 = MeasureParagraphHeight(hdc, g_hFontText, w, p1);
-        lastBottom = max(lastBottom, yCur + h1);
-        yCur += S(40);
-
-        std::wstring p2 = L"- Ganadora de los premios Clarin y Martin Fierro 2005";
-        DrawParagraph(hdc, x, yCur + yOff, w, p2);
-        int h2 = MeasureParagraphHeight(hdc, g_hFontText, w, p2);
-        lastBottom = max(lastBottom, yCur + h2);
-        yCur += S(40);
-
-        std::wstring p3 = L"- Cantina Chichilo de Buenos Aires desde hace 65 aos al servicio del buen comer atendidos por sus dueos en un barrio de famosos La Paternal. Adems la produccin de pol-ka la eligi para la apertura de la novela ilusiones y el sodero de mi vida, adems es el lugar preferido de Diego Maradona";
-        DrawParagraph(hdc, x, yCur + yOff, w, p3);
-        int h3 = MeasureParagraphHeight(hdc, g_hFontText, w, p3);
-        lastBottom = max(lastBottom, yCur + h3);
-
-        int logicalBottom = max(lastBottom, yCur) + S(20);
-        g_contentH = (logicalBottom - card.top) + S(10);
-    } break;
-
-    case SEC_HORARIOS: {
-        int yCur = y;
-        DrawTextLine(hdc, g_hFontTitle, RGB(30, 30, 30), x, yCur + yOff, L"Horarios");
-        yCur += S(50);
-
-        const wchar_t* lines[] = {
-            L"- Lunes de 20:30 a 00:00 hs",
-            L"- Martes de 20:30 a 00:00 hs",
-            L"- Miercoles de 20:30 a 00:00 hs",
-            L"- Jueves de 20:30 a 00:00 hs",
-            L"- Viernes de 20:30 a 00:00 hs",
-            L"- Sbados de 12:30 a 14:30 hs",
-            L"- Domingos de 12:30 a 14:30 hs"
-        };
-        int lastBottom = yCur;
-        for (auto s : lines) {
-            std::wstring t = s;
-            DrawParagraph(hdc, x, yCur + yOff, w, t);
-            int ht = MeasureParagraphHeight(hdc, g_hFontText, w, t);
-            lastBottom = max(lastBottom, yCur + ht);
-            yCur += S(40);
-        }
+    Extent Measure(FontId font, const std::wstring& s) override {
+        SIZE sz{}; HGDIOBJ old = SelectObject(hdc_, FontFor(font));
+        GetTextExtentPoint32W(hdc_, s.c_str(), (int)s.size(), &sz);
+        SelectObject(hdc_, old);
+        return Extent{ (int)sz.cx, (int)sz.cy };
+    }
 
-        int logicalBottom = max(lastBottom, yCur) + S(20);
-        g_contentH = (logicalBottom - card.top) + S(10);
-    } break;
-
-    case SEC_CONTACTO: {
-        int yCur = y;
-
-        // Ttulo
-        DrawTextLine(hdc, g_hFontTitle, RGB(30, 30, 30), x, yCur + yOff, L"Contacto");
-        yCur += S(50);
-
-        // ===== Columna derecha: MAPA =====
-        // Tamao sugerido del recuadro del mapa
-        const int rightColW = S(420);
-        const int mapH = S(320);
-
-        RECT mapRect{
-            card.right - pad - rightColW,
-            y + yOff,                      // alineado con el inicio del contenido
-            card.right - pad,
-            y + mapH + yOff
-        };
-        DrawRoundedRect(hdc, mapRect, 12, RGB(255, 255, 255), RGB(235, 215, 190));
-        RECT mapInner = mapRect; InflateRect(&mapInner, -S(14), -S(14));
-        DrawBitmapFromResourceFitRect(hdc, mapInner, IDB_MAPA);
-
-        // ===== Columna izquierda: texto =====
-        const int leftColW = w - (rightColW + S(20)); // deja espacio para el mapa y un gap
-        const wchar_t* lines[] = {
-            L"Direccin: Camarones 1901, Esquina Terrero 2006",
-            L"Capital Federal",
-            L"Reservas: 011-4581-1984 / 011-4584-1263",
-            L"Email: cantinachichilo@cantinachichilo.com.ar",
-            L"Email: chichilo3554@hotmail.com"
-        };
-
-        int lastBottom = yCur;
-        for (auto s : lines) {
-            std::wstring t = s;
-            DrawParagraph(hdc, x, yCur + yOff, leftColW, t);
-            // Si ests usando mi versin con MeasureParagraphHeight:
-            int ht = MeasureParagraphHeight(hdc, g_hFontText, leftColW, t);
-            lastBottom = max(lastBottom, yCur + ht);
-            yCur += S(30);
-        }
+    void Paragraph(int x, int y, int w, const std::wstring& text) override {
+        DrawParagraph(hdc_, x, y, w, text);
+    }
+
+    int ParagraphHeight(int w, const std::wstring& text) override {
+        return MeasureParagraphHeight(hdc_, g_hFontText, w, text);
+    }
+
+    Rect Image(const Rect& dest, int resId) override {
+        return DrawBitmapFromResourceFitRect(hdc_, dest, resId);
+    }
+
+    void Header(const Rect& r) override;
+
+    void SetClip(const Rect& r) override {
+        HRGN rgn = CreateRectRgn(r.left, r.top, r.right, r.bottom);
+        SelectClipRgn(hdc_, rgn); // el DC se queda con una copia
+        DeleteObject(rgn);
+    }
+
+    void ClearClip() override { SelectClipRgn(hdc_, nullptr); }
 
-        // Alto lgico total: mximo entre texto y mapa
-        int logicalBottom = max(lastBottom, (mapRect.bottom - yOff)) + S(20);
-        g_contentH = (logicalBottom - card.top) + S(10);
-    } break;
+private:
+    HDC hdc_;
+};
+
+// El header solo depende del ancho y del DPI: se pinta una vez por set y se copia.
+// En modo rpido un ancho nuevo no repinta la capa: el degradado es igual en toda
+// la fila y el texto est a la izquierda, as que se estira la ltima columna.
+static void PaintHeader(HDC hdc, const RECT& r) {
+    int w = r.right - r.left;
+    int h = r.bottom - r.top;
+
+    HDC mem = CreateCompatibleDC(hdc);
+    if (g_res->header && g_res->headerW != w && g_gov.quality == QUALITY_FAST) {
+        HGDIOBJ old = SelectObject(mem, g_res->header);
+        int keep = min(w, g_res->headerW);
+        BitBlt(hdc, r.left, r.top, keep, h, mem, 0, 0, SRCCOPY);
+        if (w > keep) {
+            SetStretchBltMode(hdc, COLORONCOLOR);
+            StretchBlt(hdc, r.left + keep, r.top, w - keep, h,
+                mem, g_res->headerW - 1, 0, 1, h, SRCCOPY);
+        }
+        SelectObject(mem, old);
+        DeleteDC(mem);
+        return;
     }
+    if (!g_res->header || g_res->headerW != w) {
+        if (g_res->header) DeleteObject(g_res->header);
+        g_res->header = CreateCompatibleBitmap(hdc, w, h);
+        g_res->headerW = w;
+        HGDIOBJ old = SelectObject(mem, g_res->header);
+        GdiCanvas layer(mem);
+        PaintHeaderLayer(layer, Rect{ 0, 0, w, h });
+        SelectObject(mem, old);
+    }
+    HGDIOBJ old = SelectObject(mem, g_res->header);
+    BitBlt(hdc, r.left, r.top, w, h, mem, 0, 0, SRCCOPY);
+    SelectObject(mem, old);
+    DeleteDC(mem);
+}
 
-    // Quitar clip
-    SelectClipRgn(hdc, nullptr);
-    DeleteObject(rgn);
+void GdiCanvas::Header(const Rect& r) { PaintHeader(hdc_, ToRECT(r)); }
+// Back buffer de 32 bpp (0x00RRGGBB, fila 0 arriba) con acceso a los pxeles
+static HBITMAP CreateFrameDib(HDC hdc, int w, int h, std::uint32_t** pixels) {
+    BITMAPINFO bi{};
+    bi.bmiHeader.biSize = sizeof(bi.bmiHeader);
+    bi.bmiHeader.biWidth = w;
+    bi.bmiHeader.biHeight = -h;
+    bi.bmiHeader.biPlanes = 1;
+    bi.bmiHeader.biBitCount = 32;
+    bi.bmiHeader.biCompression = BI_RGB;
+    void* bits = nullptr;
+    HBITMAP bmp = CreateDIBSection(hdc, &bi, DIB_RGB_COLORS, &bits, nullptr, 0);
+    *pixels = (std::uint32_t*)bits;
+    return bmp;
 }
 
-void DoPaint(HWND hWnd) {
-    PAINTSTRUCT ps; HDC hdc = BeginPaint(hWnd, &ps);
-    RECT rc; GetClientRect(hWnd, &rc);
+// Back buffer del hilo de render. En calidad completa se ajusta al rea cliente;
+// en modo rpido solo se vuelve a reservar si queda chico, y con margen, para no
+// crear un bitmap en cada frame de un resize.
+static HBITMAP g_backBuffer = nullptr;
+static int g_backW = 0, g_backH = 0;
+static const int kBackBufferSlack = 256; // pxeles extra al crecer en modo rpido
+
+static HBITMAP AcquireBackBuffer(HDC hdc, int w, int h) {
+    bool fast = g_gov.quality == QUALITY_FAST;
+    bool reuse = fast ? (g_backW >= w && g_backH >= h) : (g_backW == w && g_backH == h);
+    if (g_backBuffer && reuse) return g_backBuffer;
+
+    if (g_backBuffer) DeleteObject(g_backBuffer);
+    g_backW = fast ? w + kBackBufferSlack : w;
+    g_backH = fast ? h + kBackBufferSlack : h;
+    g_backBuffer = CreateCompatibleBitmap(hdc, g_backW, g_backH);
+    if (!g_backBuffer) g_backW = g_backH = 0;
+    return g_backBuffer;
+}
 
+static void ReleaseBackBuffer() {
+    if (g_backBuffer) DeleteObject(g_backBuffer);
+    g_backBuffer = nullptr;
+    g_backW = g_backH = 0;
+}
+
+// Pinta el snapshot en un back buffer y lo presenta (hilo de render)
+static void RenderFrame(HWND hWnd, const UiSnapshot& snap) {
+    if (snap.width <= 0 || snap.height <= 0) return;
+
+    LARGE_INTEGER t0, t1, freq;
+    QueryPerformanceCounter(&t0);
+
+    if (!g_res || g_res->dpi != snap.dpi) {
+        g_dpiTransition = g_res != nullptr;
+        g_dpiFrom = g_res ? g_res->dpi : snap.dpi;
+        g_dpiTransitionHit = ActivateDpi(snap.dpi);
+    }
+    ChooseQuality(snap);
+
+    HDC hdc = GetDC(hWnd);
     HDC mem = CreateCompatibleDC(hdc);
-    HBITMAP bmp = CreateCompatibleBitmap(hdc, rc.right - rc.left, rc.bottom - rc.top);
+    std::uint32_t* pixels = nullptr;
+    // El modo de sobre-pintado necesita un DIB propio para mezclar el heatmap
+    HBITMAP bmp = snap.overdraw
+        ? CreateFrameDib(hdc, snap.width, snap.height, &pixels)
+        : AcquireBackBuffer(hdc, snap.width, snap.height);
     HGDIOBJ oldBmp = SelectObject(mem, bmp);
 
-    FillRectColor(mem, rc, RGB(252, 250, 247));
+    auto layout = std::make_unique<LayoutResult>();
+    layout->seq = snap.seq;
+    GdiCanvas canvas(mem);
+    if (snap.overdraw && pixels) {
+        g_overdraw.Reset(snap.width, snap.height);
+        CountingCanvas counting(canvas, g_overdraw);
+        PaintFrame(counting, snap, *layout);
+        GdiFlush();
+        g_overdraw.BlendHeatmap(pixels, snap.width, kHeatmapAlpha);
+        OutputDebugStringW(g_overdraw.Summary(snap.cause, g_dpi).c_str());
+    }
+    else PaintFrame(canvas, snap, *layout);
+
+    BitBlt(hdc, 0, 0, snap.width, snap.height, mem, 0, 0, SRCCOPY);
+    SelectObject(mem, oldBmp); DeleteDC(mem);
+    if (snap.overdraw) DeleteObject(bmp);
+    ReleaseDC(hWnd, hdc);
+
+    // La barra de scroll y el hit-testing se actualizan en el hilo de UI
+    g_layouts.Publish(std::move(layout));
+    PostMessageW(hWnd, WM_APP_LAYOUT, 0, 0);
+
+    QueryPerformanceCounter(&t1);
+    QueryPerformanceFrequency(&freq);
+    EndFrame((t1.QuadPart - t0.QuadPart) * 1000.0 / freq.QuadPart);
+
+    if (g_dpiTransition) {
+        ReportDpiTransition();
+        g_dpiTransition = false;
+    }
+}
+
+static void RenderThreadProc(HWND hWnd) {
+    std::unique_ptr<const UiSnapshot> last;
+    DWORD timeout = INFINITE;
+    for (;;) {
+        DWORD wait = WaitForSingleObject(g_renderWake, timeout);
+        if (g_renderQuit.load()) break;
+
+        auto snap = g_snapshots.Take();
+        if (snap) last = std::move(snap);
+        else if (wait != WAIT_TIMEOUT || !last) continue;
+        else {
+            // Sin entrada nueva: se repite el ltimo estado en calidad completa
+            g_gov.forceFull = g_gov.quality == QUALITY_FAST;
+            if (g_hasProvisional) RefineProvisionalImages();
+        }
+        RenderFrame(hWnd, *last);
+
+        if (g_gov.quality == QUALITY_FAST) timeout = QUALITY_SETTLE_MS;
+        else if (g_hasProvisional) timeout = kRefineDelayMs;
+        else timeout = INFINITE;
+    }
+}
 
-    PaintHeader(mem, rc);
-    PaintSectionBar(mem, rc);
-    PaintContent(mem, rc);
+// Publica el estado actual para el hilo de render (hilo de UI).
+// cause = evento que pidi el frame, para las estadsticas de sobre-pintado.
+static void RequestFrame(HWND hWnd, const wchar_t* cause) {
+    RECT rc; GetClientRect(hWnd, &rc);
+    auto snap = std::make_unique<UiSnapshot>();
+    snap->section = g_section;
+    snap->plato = g_platoSeleccionado;
+    snap->especial = g_especialSeleccionada;
+    snap->scrollPos = g_vscrollPos;
+    snap->width = rc.right - rc.left;
+    snap->height = rc.bottom - rc.top;
+    snap->dpi = g_dpi;
+    snap->liveResize = g_liveResize;
+    snap->fastScroll = IsFastScrolling();
+    snap->busqueda = g_busqueda;
+    snap->platos = g_platosVisibles;
+    snap->especiales = g_especialesVisibles;
+    snap->overdraw = g_overdrawOn;
+    snap->cause = cause;
+    g_layoutGate.Stamp(*snap);
+    g_snapshots.Publish(std::move(snap));
+    SetEvent(g_renderWake);
+}
 
-    // Actualizamos la barra de scroll con las medidas calculadas
+// Toma el ltimo layout del hilo de render (hilo de UI). Un layout de antes del
+// ltimo cambio de forma se descarta: el frame del estado nuevo ya est en camino.
+static void ApplyLayout(HWND hWnd) {
+    auto layout = g_layouts.Take();
+    if (!layout || !g_layoutGate.Accept(layout->seq)) return;
+    g_platoRects = layout->platoRects;
+    g_especialRects = layout->especialRects;
+    g_platoIndex = layout->platoIndex;
+    g_especialIndex = layout->especialIndex;
+    g_layoutScroll = layout->scrollPos;
+    g_viewportH = layout->viewportH;
+    g_contentH = layout->contentH;
+
+    // Si el contenido se achic, ApplyScrollBar recorta el scroll: hay que repintar
+    int before = g_vscrollPos;
     ApplyScrollBar(hWnd);
+    if (g_vscrollPos != before) RequestFrame(hWnd, L"layout");
+}
 
-    BitBlt(hdc, 0, 0, rc.right - rc.left, rc.bottom - rc.top, mem, 0, 0, SRCCOPY);
-    SelectObject(mem, oldBmp); DeleteObject(bmp); DeleteDC(mem);
+static void StartRenderThread(HWND hWnd) {
+    g_renderWake = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    g_renderQuit = false;
+    g_renderThread = std::thread(RenderThreadProc, hWnd);
+}
 
-    EndPaint(hWnd, &ps);
+static void StopRenderThread() {
+    g_renderQuit = true;
+    SetEvent(g_renderWake);
+    if (g_renderThread.joinable()) g_renderThread.join();
+    CloseHandle(g_renderWake);
+    g_renderWake = nullptr;
+    ReleaseBackBuffer();
+    DestroyDpiSets();
 }
 
 // -------------------- DPI / Mica --------------------
@@ -537,7 +843,6 @@ void UpdateDPI(HWND hWnd) {
     HDC hdc = GetDC(hWnd);
     g_dpi = GetDeviceCaps(hdc, LOGPIXELSX);
     ReleaseDC(hWnd, hdc);
-    DeleteFonts(); InitFonts();
 }
 
 void SetMica(HWND h) {
@@ -553,29 +858,43 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     case WM_CREATE:
         UpdateDPI(hWnd);
         SetMica(hWnd);
+        BuildMenuIndex();
+        StartRenderThread(hWnd);
         return 0;
 
-    case WM_DPICHANGED:
+    case WM_DPICHANGED: {
+        LARGE_INTEGER now; QueryPerformanceCounter(&now);
+        g_dpiChangeStart = now.QuadPart;
         g_dpi = HIWORD(wParam);
-        DeleteFonts(); InitFonts();
         if (RECT* prcNew = (RECT*)lParam)
             MoveWindow(hWnd, prcNew->left, prcNew->top, prcNew->right - prcNew->left,
                 prcNew->bottom - prcNew->top, TRUE);
-        InvalidateRect(hWnd, nullptr, TRUE);
+        RequestFrame(hWnd, L"dpi");
         return 0;
+    }
 
     case WM_SIZE:
-        InvalidateRect(hWnd, nullptr, TRUE);
+        RequestFrame(hWnd, L"resize");
+        return 0;
+
+    case WM_ENTERSIZEMOVE:
+        g_liveResize = true;
+        return 0;
+
+    case WM_EXITSIZEMOVE:
+        g_liveResize = false;
+        RequestFrame(hWnd, L"fin de resize");
         return 0;
 
     case WM_MOUSEWHEEL:
         if (g_vscrollMax > 0) {
+            NoteScroll();
             int delta = GET_WHEEL_DELTA_WPARAM(wParam); // 120 por notch
             int step = S(60);
             if (delta > 0) g_vscrollPos = max(0, g_vscrollPos - step);
             else           g_vscrollPos = min(g_vscrollMax, g_vscrollPos + step);
             SetScrollPos(hWnd, SB_VERT, g_vscrollPos, TRUE);
-            InvalidateRect(hWnd, nullptr, TRUE);
+            RequestFrame(hWnd, L"rueda");
         }
         return 0;
 
@@ -598,9 +917,10 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         }
         pos = max(0, min(g_vscrollMax, pos));
         if (pos != g_vscrollPos) {
+            NoteScroll();
             g_vscrollPos = pos;
             SetScrollPos(hWnd, SB_VERT, g_vscrollPos, TRUE);
-            InvalidateRect(hWnd, nullptr, TRUE);
+            RequestFrame(hWnd, L"scrollbar");
         }
         return 0;
     }
@@ -610,31 +930,34 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         POINT pt{ GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
 
         // Tabs
-        RECT bar = SectionBarRect(rc);
+        Rect bar = SectionBarRect(FromRECT(rc), g_dpi);
         auto rects = BuildTabRects(bar);
         for (size_t i = 0; i < rects.size(); ++i) {
-            if (PtInRect(&rects[i], pt)) {
+            if (Contains(rects[i], pt.x, pt.y)) {
                 g_section = kTabs[i].id;
                 // reset scroll al cambiar de seccin
                 g_vscrollPos = 0;
-                InvalidateRect(hWnd, nullptr, TRUE);
+                RequestFrame(hWnd, L"click");
                 return 0;
             }
         }
 
-        // Interacciones de Carta (hit-test con rects ya offseteados)
-        if (g_section == SEC_CARTA) {
+        // Interacciones de Carta (hit-test con rects ya offseteados). Los rects
+        // pueden venir de un frame con otro scroll: se corrige el punto. Si todava
+        // no lleg el layout del estado actual, los rects son de otra Carta.
+        if (g_section == SEC_CARTA && g_layoutGate.Current()) {
+            POINT hit{ pt.x, pt.y + g_vscrollPos - g_layoutScroll };
             for (size_t i = 0; i < g_platoRects.size(); ++i) {
-                if (PtInRect(&g_platoRects[i], pt)) {
-                    g_platoSeleccionado = kPlatos[i].id;
-                    InvalidateRect(hWnd, nullptr, TRUE);
+                if (Contains(g_platoRects[i], hit.x, hit.y)) {
+                    g_platoSeleccionado = kPlatos[g_platoIndex[i]].id;
+                    RequestFrame(hWnd, L"click");
                     return 0;
                 }
             }
             for (size_t i = 0; i < g_especialRects.size(); ++i) {
-                if (PtInRect(&g_especialRects[i], pt)) {
-                    g_especialSeleccionada = kEspeciales[i].id;
-                    InvalidateRect(hWnd, nullptr, TRUE);
+                if (Contains(g_especialRects[i], hit.x, hit.y)) {
+                    g_especialSeleccionada = kEspeciales[g_especialIndex[i]].id;
+                    RequestFrame(hWnd, L"click");
                     return 0;
                 }
             }
@@ -642,17 +965,98 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam) {
         return 0;
     }
 
-    case WM_PAINT:
-        DoPaint(hWnd);
+    case WM_CHAR: {
+        // Bsqueda incremental en la Carta
+        if (g_section != SEC_CARTA) return 0;
+        wchar_t c = (wchar_t)wParam;
+        if (c == VK_BACK) {
+            if (g_busqueda.empty()) return 0;
+            g_busqueda.pop_back();
+        }
+        else if (c == VK_ESCAPE) {
+            if (g_busqueda.empty()) return 0;
+            g_busqueda.clear();
+        }
+        else if (c >= L' ') g_busqueda.push_back(c);
+        else return 0;
+
+        UpdateCartaFilter();
+        g_vscrollPos = 0;
+        RequestFrame(hWnd, L"teclado");
         return 0;
+    }
+
+    case WM_KEYDOWN:
+        if (wParam == VK_F2) {
+            g_overdrawOn = !g_overdrawOn;
+            RequestFrame(hWnd, L"F2");
+            return 0;
+        }
+        break;
+
+    case WM_APP_LAYOUT:
+        ApplyLayout(hWnd);
+        return 0;
+
+    case WM_ERASEBKGND:
+        return 1; // el hilo de render cubre toda el rea cliente
+
+    case WM_PAINT: {
+        // Solo se valida la regin; el frame lo presenta el hilo de render
+        PAINTSTRUCT ps;
+        BeginPaint(hWnd, &ps);
+        EndPaint(hWnd, &ps);
+        RequestFrame(hWnd, L"WM_PAINT");
+        return 0;
+    }
 
     case WM_DESTROY:
-        DeleteFonts(); PostQuitMessage(0);
+        StopRenderThread(); PostQuitMessage(0);
         return 0;
     }
     return DefWindowProcW(hWnd, msg, wParam, lParam);
 }
 
+// -------------------- Modo headless --------------------
+bool RunOverdrawHeadless(const wchar_t* outPath) {
+    FILE* f = nullptr;
+    if (_wfopen_s(&f, outPath, L"w") != 0 || !f) return false;
+
+    static const int kDpis[] = { 96, 144, 192 };
+    BuildMenuIndex();
+    for (int dpi : kDpis) {
+        ActivateDpi(dpi);
+        for (const auto& t : kTabs) {
+            UiSnapshot snap;
+            snap.section = t.id;
+            snap.width = S(1084);  // rea cliente de la ventana de 1100x720
+            snap.height = S(681);
+            snap.dpi = dpi;
+            snap.platos = g_platosVisibles;
+            snap.especiales = g_especialesVisibles;
+            snap.overdraw = true;
+            snap.cause = t.label;
+
+            HDC mem = CreateCompatibleDC(nullptr);
+            std::uint32_t* pixels = nullptr;
+            HBITMAP bmp = CreateFrameDib(mem, snap.width, snap.height, &pixels);
+            HGDIOBJ oldBmp = SelectObject(mem, bmp);
+
+            LayoutResult layout;
+            g_overdraw.Reset(snap.width, snap.height);
+            GdiCanvas canvas(mem);
+            CountingCanvas counting(canvas, g_overdraw);
+            PaintFrame(counting, snap, layout);
+            fputws(g_overdraw.Summary(snap.cause, dpi).c_str(), f);
+
+            SelectObject(mem, oldBmp); DeleteObject(bmp); DeleteDC(mem);
+        }
+    }
+    DestroyDpiSets();
+    fclose(f);
+    return true;
+}
+
 // -------------------- Registro --------------------
 void RegisterChichiloWindow(HINSTANCE hInst) {
     WNDCLASSEXW wc{ sizeof(wc) };
@@ -666,16 +1070,8 @@ void RegisterChichiloWindow(HINSTANCE hInst) {
 }
 
 void DrawBitmapFromResource(HDC hdc, int x, int y, int resId) {
-    HBITMAP hBmp = LoadBitmap(GetModuleHandle(nullptr), MAKEINTRESOURCE(resId));
-    if (!hBmp) return;
-
-    BITMAP bm; GetObject(hBmp, sizeof(bm), &bm);
-    HDC hMemDC = CreateCompatibleDC(hdc);
-    HGDIOBJ oldBmp = SelectObject(hMemDC, hBmp);
-
-    BitBlt(hdc, x, y, bm.bmWidth, bm.bmHeight, hMemDC, 0, 0, SRCCOPY);
-
-    SelectObject(hMemDC, oldBmp);
-    DeleteDC(hMemDC);
-    DeleteObject(hBmp);
+    DibView dib;
+    if (!LoadDibResource(resId, dib)) return;
+    StretchDIBits(hdc, x, y, dib.width, dib.height, 0, 0, dib.width, dib.height,
+        dib.bits, (const BITMAPINFO*)dib.info, DIB_RGB_COLORS, SRCCOPY);
 }
@@ -6,6 +6,27 @@
 #define DPI_AWARE 1
 #endif
 
+// Calidad adaptativa durante resize/scroll. El log ([Calidad] en la salida de
+// depuracin) sale solo cuando cambia la calidad, con el motivo y la duracin del
+// ltimo frame completo; loguear cada decisin sera una lnea por frame.
+// QUALITY_POLICY: 0 = siempre HALFTONE, 1 = reusar la ltima imagen escalada,
+//                 2 = reescalar desde el recurso con COLORONCOLOR
+#ifndef QUALITY_POLICY
+#define QUALITY_POLICY 1
+#endif
+#ifndef QUALITY_FRAME_BUDGET_MS
+#define QUALITY_FRAME_BUDGET_MS 16   // un frame completo ms lento que esto activa el modo rpido
+#endif
+#ifndef QUALITY_FAST_SCROLL_MS
+#define QUALITY_FAST_SCROLL_MS 80    // dos eventos de scroll ms cercanos que esto = scroll rpido
+#endif
+#ifndef QUALITY_SETTLE_MS
+#define QUALITY_SETTLE_MS 150        // sin entrada durante esto = frame de calidad completa
+#endif
+#ifndef QUALITY_PROBE_MS
+#define QUALITY_PROBE_MS 500         // en modo rpido, cada cunto se vuelve a medir un frame completo
+#endif
+
 // Nombre de clase de ventana
 extern const wchar_t* kAppClass;
 
@@ -15,4 +36,8 @@ void RegisterChichiloWindow(HINSTANCE hInst);
 // Proc principal (visible porque lo necesita ui.cpp)
 LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
-void DrawBitmapFromResource(HDC hdc, int x, int y, int resId);
\ No newline at end of file
+void DrawBitmapFromResource(HDC hdc, int x, int y, int resId);
+
+// Sin ventana: pinta cada seccin en memoria y escribe las estadsticas de
+// sobre-pintado en outPath, una lnea por seccin y DPI
+bool RunOverdrawHeadless(const wchar_t* outPath);
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+#include <atomic>
+#include <cstdio>
+
+// Mini framework de las pruebas de Linux: cada CHECK que falla se informa y el
+// ejecutable termina con cdigo 1 para que ctest lo marque.
+static std::atomic<int> g_failures{ 0 };
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "%s:%d: fall\u00f3 CHECK(%s)\n", __FILE__, __LINE__, #cond); \
+            ++g_failures; \
+        } \
+    } while (0)
+
+inline int TestResult(const char* name) {
+    if (g_failures) std::fprintf(stderr, "%s: %d fallas\n", name, g_failures.load());
+    else std::printf("%s: ok\n", name);
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,185 @@
+// Parser de DIB contra los .bmp reales del repo (24 bits, bottom-up, algunos con
+// padding al final de cada fila) y contra casos sintticos.
+#include "Check.h"
+#include "DibView.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+typedef std::vector<std::uint8_t> Bytes;
+
+static void PutU16(Bytes& b, std::size_t at, std::uint16_t v) {
+    b[at] = (std::uint8_t)v; b[at + 1] = (std::uint8_t)(v >> 8);
+}
+
+static void PutU32(Bytes& b, std::size_t at, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) b[at + i] = (std::uint8_t)(v >> (8 * i));
+}
+
+static Bytes ReadFile(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    return Bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+}
+
+// BITMAPINFOHEADER + 'paletteEntries' RGBQUAD en cero + 'bitsSize' bytes de pxeles
+static Bytes MakeDib(int w, int h, int bitCount, std::uint32_t clrUsed,
+                     std::size_t paletteEntries, std::size_t bitsSize) {
+    Bytes b(40 + paletteEntries * 4 + bitsSize, 0);
+    PutU32(b, 0, 40);
+    PutU32(b, 4, (std::uint32_t)w);
+    PutU32(b, 8, (std::uint32_t)h);
+    PutU16(b, 12, 1);
+    PutU16(b, 14, (std::uint16_t)bitCount);
+    PutU32(b, 32, clrUsed);
+    return b;
+}
+
+// ---- Archivos del repo ----
+struct RepoBmp { const char* name; int width; int height; std::size_t stride; };
+
+static const RepoBmp kRepoBmps[] = {
+    { "calamarettis.bmp", 246, 205, 740 },  // 738 bytes de datos + 2 de padding
+    { "caracoles.bmp",    700, 461, 2100 },
+    { "mapa.bmp",         665, 640, 1996 }, // 1995 + 1
+    { "merluza.bmp",     1300, 867, 3900 },
+    { "mondongo.bmp",     686, 386, 2060 }, // 2058 + 2
+    { "quintos.bmp",      992, 661, 2976 },
+    { "rabas.bmp",       1200, 675, 3600 },
+    { "ranas.bmp",       1400, 788, 4200 },
+    { "rinones.bmp",      640, 480, 1920 },
+};
+
+static std::uint32_t Bgr(const std::uint8_t* p) {
+    return ((std::uint32_t)p[2] << 16) | ((std::uint32_t)p[1] << 8) | p[0];
+}
+
+static void RepoFiles() {
+    for (const auto& r : kRepoBmps) {
+        Bytes file = ReadFile(std::string(PGE_SRC_DIR "/") + r.name);
+        CHECK(!file.empty());
+        if (file.empty()) continue;
+
+        DibView v;
+        CHECK(ParseBmpFile(file.data(), file.size(), v));
+        CHECK(v.width == r.width && v.height == r.height);
+        CHECK(v.bitCount == 24 && v.bottomUp && v.stride == r.stride);
+        CHECK(v.bits == file.data() + 54);
+
+        // El recurso RT_BITMAP es el mismo archivo sin BITMAPFILEHEADER
+        DibView packed;
+        CHECK(ParsePackedDib(file.data() + 14, file.size() - 14, packed));
+        CHECK(packed.bits == v.bits && packed.stride == v.stride);
+
+        // Bottom-up: la primera fila del archivo es la de abajo. El ltimo pxel de
+        // cada fila queda justo antes del padding.
+        const std::uint8_t* firstRow = file.data() + 54;
+        const std::uint8_t* lastRow = firstRow + (std::size_t)(r.height - 1) * r.stride;
+        std::size_t lastPixel = (std::size_t)(r.width - 1) * 3;
+        CHECK(DibRow(v, r.height - 1) == firstRow);
+        CHECK(DibRow(v, 0) == lastRow);
+        CHECK(DibPixel(v, 0, r.height - 1) == Bgr(firstRow));
+        CHECK(DibPixel(v, r.width - 1, r.height - 1) == Bgr(firstRow + lastPixel));
+        CHECK(DibPixel(v, r.width - 1, 0) == Bgr(lastRow + lastPixel));
+        CHECK(DibPixel(v, r.width / 2, r.height / 2)
+            == Bgr(file.data() + 54 + (std::size_t)(r.height - 1 - r.height / 2) * r.stride + (r.width / 2) * 3));
+
+        // Un byte menos ya no alcanza para la ltima fila
+        CHECK(!ParseBmpFile(file.data(), file.size() - 1, v));
+        CHECK(!ParsePackedDib(file.data() + 14, file.size() - 15, v));
+    }
+}
+
+// ---- Casos sintticos ----
+static void TopDown() {
+    // 3x2 a 24 bits: 9 bytes de datos + 3 de padding por fila
+    Bytes b = MakeDib(3, -2, 24, 0, 0, 2 * 12);
+    b[40] = 0x01; b[41] = 0x02; b[42] = 0x03;      // (0,0)
+    b[52] = 0x04; b[53] = 0x05; b[54] = 0x06;      // (0,1)
+    b[46] = 0x07; b[47] = 0x08; b[48] = 0x09;      // (2,0), antes del padding
+    DibView v;
+    CHECK(ParsePackedDib(b.data(), b.size(), v));
+    CHECK(!v.bottomUp && v.height == 2 && v.stride == 12);
+    CHECK(DibRow(v, 0) == b.data() + 40);
+    CHECK(DibPixel(v, 0, 0) == 0x030201);
+    CHECK(DibPixel(v, 0, 1) == 0x060504);
+    CHECK(DibPixel(v, 2, 0) == 0x090807);
+}
+
+static void Palette4bpp() {
+    // 5x2 a 4 bits: 3 bytes de datos + 1 de padding por fila, paleta completa de 16
+    Bytes b = MakeDib(5, 2, 4, 0, 16, 2 * 4);
+    PutU32(b, 40 + 7 * 4, 0x00AB0000);  // RGBQUAD 7 = rojo AB
+    PutU32(b, 40 + 2 * 4, 0x000000CD);  // RGBQUAD 2 = azul CD
+    std::size_t bits = 40 + 16 * 4;
+    b[bits + 4] = 0x72;  // fila de arriba (segunda en memoria): x=0 -> 7, x=1 -> 2
+    b[bits + 6] = 0x20;  // x=4 -> 2 (nibble alto del tercer byte)
+    DibView v;
+    CHECK(ParsePackedDib(b.data(), b.size(), v));
+    CHECK(v.paletteSize == 16 && v.palette == b.data() + 40);
+    CHECK(v.bits == b.data() + bits && v.stride == 4);
+    CHECK(DibPixel(v, 0, 0) == 0xAB0000);
+    CHECK(DibPixel(v, 1, 0) == 0x0000CD);
+    CHECK(DibPixel(v, 4, 0) == 0x0000CD);
+    CHECK(DibPixel(v, 0, 1) == 0);
+
+    // biClrUsed = 3: la paleta ocupa solo 3 entradas y un ndice fuera de ella da negro
+    Bytes c = MakeDib(5, 2, 4, 3, 3, 2 * 4);
+    c[40 + 3 * 4 + 4] = 0x90;
+    CHECK(ParsePackedDib(c.data(), c.size(), v));
+    CHECK(v.paletteSize == 3 && v.bits == c.data() + 40 + 3 * 4);
+    CHECK(DibPixel(v, 0, 0) == 0);
+}
+
+static void LargePaletteOnTrueColor() {
+    // 24 bits con biClrUsed = 300: los pxeles empiezan despus de las 300 entradas
+    Bytes b = MakeDib(1, 1, 24, 300, 300, 4);
+    std::size_t bits = 40 + 300 * 4;
+    b[bits] = 0x11; b[bits + 1] = 0x22; b[bits + 2] = 0x33;
+    DibView v;
+    CHECK(ParsePackedDib(b.data(), b.size(), v));
+    CHECK(v.bits == b.data() + bits);
+    CHECK(v.paletteSize == 256 && v.palette == b.data() + 40);
+    CHECK(DibPixel(v, 0, 0) == 0x332211);
+
+    // Si la paleta declarada no entra en el buffer, se rechaza
+    Bytes t = MakeDib(1, 1, 24, 300, 0, 4);
+    CHECK(!ParsePackedDib(t.data(), t.size(), v));
+}
+
+static void Truncated() {
+    DibView v;
+    Bytes b = MakeDib(4, 4, 24, 0, 0, 4 * 12);
+    CHECK(ParsePackedDib(b.data(), b.size(), v));
+    CHECK(!ParsePackedDib(b.data(), 39, v));              // cabecera incompleta
+    CHECK(!ParsePackedDib(b.data(), b.size() - 1, v));    // falta un byte de pxeles
+
+    Bytes p = MakeDib(2, 2, 8, 0, 256, 2 * 4);
+    CHECK(ParsePackedDib(p.data(), p.size(), v));
+    CHECK(!ParsePackedDib(p.data(), 40 + 100 * 4, v));    // paleta cortada
+
+    // Archivo .bmp con bfOffBits dentro de la paleta o fuera del archivo
+    Bytes f(14, 0);
+    f[0] = 'B'; f[1] = 'M';
+    f.insert(f.end(), p.begin(), p.end());
+    PutU32(f, 10, 14 + 40 + 256 * 4);
+    CHECK(ParseBmpFile(f.data(), f.size(), v));
+    PutU32(f, 10, 14 + 40 + 16 * 4);
+    CHECK(!ParseBmpFile(f.data(), f.size(), v));
+    PutU32(f, 10, (std::uint32_t)f.size() + 1);
+    CHECK(!ParseBmpFile(f.data(), f.size(), v));
+    f[1] = 'X';
+    CHECK(!ParseBmpFile(f.data(), f.size(), v));
+}
+
+int main() {
+    RepoFiles();
+    TopDown();
+    Palette4bpp();
+    LargePaletteOnTrueColor();
+    Truncated();
+    return TestResult("DibViewTest");
+}
@@ -0,0 +1,75 @@
+// Latencia por tecla de MenuSearch sobre una carta sinttica de 100k platos.
+// Cada consulta se tipea letra por letra como en la Carta y cada resultado se
+// compara con una bsqueda lineal (fuera del tiempo medido).
+//
+// Referencia (Linux x86-64, GCC 12, -O2): la primera o segunda tecla de una
+// consulta comn recorre decenas de miles de candidatos y tarda 6-12 ms; desde la
+// tercera letra el trigrama ms raro o el resultado previo la bajan a 2-4 ms, y
+// una consulta selectiva queda por debajo de 0,5 ms.
+#include "Check.h"
+#include "MenuSearch.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+static const int kEntries = 100000;
+
+static const wchar_t* const kWords[] = {
+    L"Ri\u00f1ones", L"al", L"Vino", L"Blanco", L"Merluza", L"ajillo", L"Gambas",
+    L"Calamarettis", L"Escarpetta", L"Mondongo", L"Italiana", L"Ranas", L"provenzal",
+    L"Caracoles", L"Bordaleza", L"Rabas", L"Calabria", L"Quinotos", L"Rhum", L"Helado",
+    L"Americana", L"Paella", L"Tortilla", L"Pollo", L"Lomo", L"Cazuela", L"Mariscos",
+    L"Fugazzeta", L"Ravioles", L"\u00d1oquis",
+};
+static const int kWordCount = sizeof(kWords) / sizeof(kWords[0]);
+
+static const wchar_t* const kQueries[] = {
+    L"RI\u00d1ONES AL VINO", // trigramas comunes: cada tecla refina miles de resultados
+    L"merluza",
+    L"noquis 4711",          // se vuelve muy selectiva al llegar a los dgitos
+    L"xq",                   // sin resultados
+};
+
+int main() {
+    std::mt19937 rng(1);
+    std::vector<std::wstring> folded;
+    MenuSearch m;
+    for (int i = 0; i < kEntries; ++i) {
+        std::wstring s;
+        for (int k = 3 + (int)(rng() % 4); k > 0; --k) { s += kWords[rng() % kWordCount]; s += L' '; }
+        s += std::to_wstring(i);
+        m.Add(s);
+        folded.push_back(FoldText(s));
+    }
+
+    double worst = 0, total = 0;
+    int keystrokes = 0;
+    for (const wchar_t* typed : kQueries) {
+        std::wstring q;
+        for (const wchar_t* c = typed; *c; ++c) {
+            q += *c;
+            auto t0 = std::chrono::steady_clock::now();
+            const std::vector<std::uint32_t>& hits = m.Search(q);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            total += ms;
+            if (ms > worst) worst = ms;
+            ++keystrokes;
+
+            std::vector<std::uint32_t> expected;
+            std::wstring fq = FoldText(q);
+            for (std::uint32_t id = 0; id < (std::uint32_t)folded.size(); ++id)
+                if (folded[id].find(fq) != std::wstring::npos) expected.push_back(id);
+            CHECK(hits == expected);
+
+            std::printf("%-18ls %7zu  %7.3f ms\n", fq.c_str(), hits.size(), ms); // plegada: ASCII
+        }
+        m.Search(L""); // como Esc en la Carta
+    }
+    std::printf("%d entradas, %d teclas: promedio %.3f ms, peor %.3f ms\n",
+        kEntries, keystrokes, total / keystrokes, worst);
+    return TestResult("MenuSearchBench");
+}
@@ -0,0 +1,83 @@
+// ndice de trigramas de la Carta: plegado de acentos y comparacin aleatoria
+// contra una bsqueda lineal, incluido el refinamiento incremental.
+#include "Check.h"
+#include "MenuSearch.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// 'folded' ya pas por FoldText
+static std::vector<std::uint32_t> LinearScan(const std::vector<std::wstring>& folded, const std::wstring& query) {
+    std::vector<std::uint32_t> out;
+    std::wstring q = FoldText(query);
+    for (std::uint32_t id = 0; id < (std::uint32_t)folded.size(); ++id)
+        if (folded[id].find(q) != std::wstring::npos) out.push_back(id);
+    return out;
+}
+
+static void Folding() {
+    CHECK(FoldText(L"Ri\u00f1ones al Vino") == L"rinones al vino");
+    CHECK(FoldText(L"\u00c1GUILA \u00c9LITE \u00dcBER") == L"aguila elite uber");
+    CHECK(FoldText(L"\u00d7\u00f7") == L"\u00d7\u00f7"); // no son letras
+}
+
+static void Basic() {
+    MenuSearch m;
+    m.Add(L"Ranas a la Provenzal");
+    m.Add(L"Ri\u00f1ones al Vino Blanco");
+    m.Add(L"Merluza", L"con papas al ajillo");
+    CHECK(m.Size() == 3);
+    CHECK(m.Search(L"RINONES") == std::vector<std::uint32_t>{ 1 });
+    CHECK(m.Search(L"al") == (std::vector<std::uint32_t>{ 0, 1, 2 })); // "provenzal"
+    CHECK(m.Search(L"al ") == (std::vector<std::uint32_t>{ 1, 2 }));
+    CHECK(m.Search(L"ajillo") == std::vector<std::uint32_t>{ 2 }); // en la descripcin
+    CHECK(m.Search(L"za con").empty()); // no cruza de nombre a descripcin
+    CHECK(m.Search(L"merluza") == std::vector<std::uint32_t>{ 2 });
+    CHECK(m.Search(L"xyz").empty());
+    CHECK(m.Search(L"").size() == 3);
+}
+
+// Consultas tipeadas, borradas y limpiadas al azar sobre un alfabeto chico para
+// que haya muchas coincidencias parciales
+static void RandomAgainstLinearScan() {
+    static const wchar_t kAlphabet[] = L"abc\u00c1\u00c9\u00f1\u00d1o ";
+    const int kLetters = 9;
+    std::mt19937 rng(2);
+
+    MenuSearch m;
+    std::vector<std::wstring> entries;
+    for (int i = 0; i < 3000; ++i) {
+        std::wstring s;
+        for (int k = (int)(rng() % 12); k > 0; --k) s += kAlphabet[rng() % kLetters];
+        entries.push_back(FoldText(s));
+        m.Add(s);
+    }
+
+    int mismatches = 0;
+    std::wstring q;
+    for (int it = 0; it < 20000; ++it) {
+        switch (rng() % 4) {
+        case 0: if (!q.empty()) q.pop_back(); break;
+        case 1: q.clear(); break;
+        default: q += kAlphabet[rng() % kLetters]; break;
+        }
+        if (q.size() > 6) q.clear();
+        if (m.Search(q) != LinearScan(entries, q)) ++mismatches;
+
+        // Agregar entradas invalida el resultado previo
+        if (it % 5000 == 4999) {
+            m.Add(q + L"zz");
+            entries.push_back(FoldText(q + L"zz"));
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+int main() {
+    Folding();
+    Basic();
+    RandomAgainstLinearScan();
+    return TestResult("MenuSearchTest");
+}
@@ -0,0 +1,104 @@
+// Sobre-pintado de los frames reales: corre PaintFrame (Frame.cpp) para cada
+// seccin y DPI, con el tamao de la ventana de 1100x720 igual que el modo
+// headless de Windows, sobre un CountingCanvas(RecordingCanvas). El texto usa las
+// mtricas fijas de RecordingCanvas y las imgenes el tamao de los .bmp del
+// repo, as que los nmeros se acercan a los de GDI pero no son idnticos.
+// Escribe una lnea por frame con el formato de F2; con un argumento tambin la
+// guarda en ese archivo.
+#include "Check.h"
+#include "Canvas.h"
+#include "DibView.h"
+#include "Frame.h"
+#include "Overdraw.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Igual que resource1.rc
+static const struct { int id; const char* file; } kBitmaps[] = {
+    { IDB_RANAS, "ranas.bmp" },
+    { IDB_CARACOLES, "caracoles.bmp" },
+    { IDB_RABAS, "rabas.bmp" },
+    { IDB_MERLUZA, "merluza.bmp" },
+    { IDB_GAMBAS, "gambas.bmp" },
+    { IDB_CALAMARETTIS, "calamarettis.bmp" },
+    { IDB_MONDONGO, "mondongo.bmp" },
+    { IDB_QUINTOS, "quintos.bmp" },
+    { IDB_RINONES, "rinones.bmp" },
+    { IDB_MAPA, "mapa.bmp" },
+    { IDB_FRENTE, "frente.bmp" },
+};
+
+static void LoadImageSizes(RecordingCanvas& c) {
+    for (const auto& b : kBitmaps) {
+        std::ifstream f(std::string(PGE_SRC_DIR) + "/" + b.file, std::ios::binary);
+        std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        // frente.bmp y gambas.bmp no estn en el repo: ocupan todo el rect destino
+        DibView dib;
+        if (data.empty()) {
+            if (c.Dpi() == 96) std::printf("sin %s: se cuenta el rect destino entero\n", b.file);
+            continue;
+        }
+        bool ok = ParseBmpFile(data.data(), data.size(), dib);
+        CHECK(ok);
+        if (ok) c.SetImageSize(b.id, dib.width, dib.height);
+    }
+}
+
+// Las causas y el formato son ASCII
+static std::string Narrow(const std::wstring& s) {
+    return std::string(s.begin(), s.end());
+}
+
+int main(int argc, char** argv) {
+    FILE* out = argc > 1 ? std::fopen(argv[1], "w") : nullptr;
+    if (argc > 1) CHECK(out != nullptr);
+
+    static const int kDpis[] = { 96, 144, 192 };
+    for (int dpi : kDpis) {
+        RecordingCanvas recording(dpi);
+        LoadImageSizes(recording);
+
+        for (const auto& t : kTabs) {
+            UiSnapshot snap;
+            snap.section = t.id;
+            snap.width = ScaleDpi(1084, dpi);
+            snap.height = ScaleDpi(681, dpi);
+            snap.dpi = dpi;
+            for (int i = 0; i < (int)(sizeof(kPlatos) / sizeof(kPlatos[0])); ++i) snap.platos.push_back(i);
+            for (int i = 0; i < (int)(sizeof(kEspeciales) / sizeof(kEspeciales[0])); ++i) snap.especiales.push_back(i);
+            snap.overdraw = true;
+            snap.cause = t.label;
+
+            OverdrawMap map;
+            map.Reset(snap.width, snap.height);
+            CountingCanvas counting(recording, map);
+            LayoutResult layout;
+            PaintFrame(counting, snap, layout);
+
+            std::string line = Narrow(map.Summary(snap.cause, dpi));
+            std::fputs(line.c_str(), stdout);
+            if (out) std::fputs(line.c_str(), out);
+
+            OverdrawMap::Stats s = map.ComputeStats();
+            int headerH = ScaleDpi(kHeaderHeight, dpi);
+            CHECK(s.touched == (std::uint64_t)snap.width * snap.height); // el fondo cubre todo
+            CHECK(s.ops > (std::uint64_t)headerH);                       // una lnea por fila del header
+            CHECK(s.average > 1.0);
+            CHECK(s.max >= 3);                                           // fondo + degradado + ttulo
+            CHECK(map.At(snap.width - 1, 0) == 2);                       // fondo + degradado
+            CHECK(map.At(snap.width - 1, headerH) == 2);                 // fondo + barra de secciones
+            if (t.id == SEC_CARTA) {
+                CHECK(layout.platoRects.size() == snap.platos.size());
+                CHECK(layout.especialRects.size() == snap.especiales.size());
+                CHECK(layout.contentH > layout.viewportH);
+            }
+        }
+    }
+    if (out) std::fclose(out);
+    return TestResult("overdraw_frames");
+}
@@ -0,0 +1,99 @@
+// Contador de sobre-pintado con una escena fija armada como un frame de la app
+// (fondo, cabecera, card con clip, botn, texto, imagen que se sale del borde).
+// Solo cubre el conteo, el clip y el heatmap; las estadsticas de los frames
+// reales las da overdraw_frames (OverdrawFramesTest.cpp).
+#include "Check.h"
+#include "Overdraw.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+static void FixedScene() {
+    OverdrawMap m;
+    m.Reset(100, 60);
+    m.AddRect(0, 0, 100, 60);       // fondo: 6000 px
+    m.AddRect(0, 0, 100, 20);       // cabecera: 2000
+    m.AddRect(10, 25, 90, 55);      // card: 2400
+    m.SetClip(12, 27, 88, 53);      // contenido del card
+    m.AddRect(0, 30, 50, 40);       // botn recortado a (12,30)-(50,40): 380
+    m.AddRect(20, 32, 40, 36);      // texto sobre el botn: 80
+    m.ClearClip();
+    m.AddRect(90, 50, 120, 70);     // imagen fuera del borde, queda (90,50)-(100,60): 100
+
+    OverdrawMap::Stats s = m.ComputeStats();
+    std::printf("escena fija: ops %llu, tocados %llu, pintados %llu, max %u, promedio %.3f\n",
+        (unsigned long long)s.ops, (unsigned long long)s.touched,
+        (unsigned long long)s.painted, s.max, s.average);
+    CHECK(s.ops == 6);
+    CHECK(s.touched == 6000);
+    CHECK(s.painted == 6000 + 2000 + 2400 + 380 + 80 + 100);
+    CHECK(s.max == 4);
+    CHECK(s.average > 1.8266 && s.average < 1.8267);
+
+    CHECK(m.At(0, 0) == 2);     // fondo + cabecera
+    CHECK(m.At(11, 30) == 2);   // card, fuera del clip del botn
+    CHECK(m.At(12, 30) == 3);   // + botn
+    CHECK(m.At(25, 33) == 4);   // + texto
+    CHECK(m.At(50, 30) == 2);   // borde derecho del botn (semiabierto)
+    CHECK(m.At(99, 59) == 2);   // imagen
+    CHECK(m.At(95, 45) == 1);
+}
+
+static void EmptyAndOffscreen() {
+    OverdrawMap m;
+    m.Reset(-5, 10);
+    m.AddRect(0, 0, 10, 10);
+    CHECK(m.Width() == 0 && m.ComputeStats().touched == 0);
+
+    m.Reset(10, 10);
+    m.AddRect(20, 20, 30, 30);
+    m.AddRect(5, 5, 2, 2);      // invertido: no pinta nada
+    m.SetClip(0, 0, 5, 5);
+    m.AddRect(6, 6, 9, 9);      // fuera del clip
+    OverdrawMap::Stats s = m.ComputeStats();
+    CHECK(s.ops == 3 && s.touched == 0 && s.painted == 0 && s.max == 0 && s.average == 0.0);
+
+    // Reset descarta el clip y los contadores del frame anterior
+    m.Reset(10, 10);
+    m.AddRect(6, 6, 9, 9);
+    CHECK(m.ComputeStats().touched == 9);
+}
+
+static void Saturates() {
+    OverdrawMap m;
+    m.Reset(1, 1);
+    for (int i = 0; i < 70000; ++i) m.AddRect(0, 0, 1, 1);
+    CHECK(m.At(0, 0) == 0xFFFF);
+    CHECK(m.ComputeStats().max == 0xFFFF);
+}
+
+static void Heatmap() {
+    CHECK(OverdrawMap::HeatColor(1) == 0x2060FF);
+    CHECK(OverdrawMap::HeatColor(5) == OverdrawMap::HeatColor(500));
+
+    OverdrawMap m;
+    m.Reset(3, 2);
+    m.AddRect(0, 0, 1, 1);
+    m.AddRect(0, 0, 2, 2);
+    // Stride mayor que el ancho: la columna extra no se toca
+    std::vector<std::uint32_t> px(4 * 2, 0xFFFFFF);
+    m.BlendHeatmap(px.data(), 4, 255);
+    CHECK(px[0] == OverdrawMap::HeatColor(2));
+    CHECK(px[1] == OverdrawMap::HeatColor(1));
+    CHECK(px[4 + 1] == OverdrawMap::HeatColor(1));
+    CHECK(px[2] == 0xFFFFFF);   // sin pintar
+    CHECK(px[3] == 0xFFFFFF);   // padding
+
+    std::vector<std::uint32_t> keep(4 * 2, 0x123456);
+    m.BlendHeatmap(keep.data(), 4, 0);
+    CHECK(keep[0] == 0x123456);
+}
+
+int main() {
+    FixedScene();
+    EmptyAndOffscreen();
+    Saturates();
+    Heatmap();
+    return TestResult("OverdrawTest");
+}
@@ -0,0 +1,128 @@
+// Estrs del buzn de snapshots: un productor publica sin parar y un consumidor
+// toma lo ltimo, como el hilo de UI y el hilo de render. Se corre con
+// -fsanitize=thread (ver CMakeLists.txt).
+#include "Check.h"
+#include "RenderState.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+static const std::uint32_t kPublishes = 200000;
+
+// Cuenta instancias vivas y marca las destruidas para detectar fugas y dobles delete
+struct Tracked {
+    static std::atomic<int> live;
+    UiSnapshot snap;
+    std::uint32_t magic = 0x5EA1ED;
+    Tracked() { ++live; }
+    ~Tracked() { CHECK(magic == 0x5EA1ED); magic = 0xDEAD; --live; }
+};
+std::atomic<int> Tracked::live{ 0 };
+
+static void StressMailbox() {
+    std::atomic<std::uint32_t> dropped{ 0 };
+    std::uint32_t taken = 0;
+    {
+        Mailbox<Tracked> mailbox;
+        std::thread producer([&] {
+            for (std::uint32_t seq = 1; seq <= kPublishes; ++seq) {
+                auto t = std::make_unique<Tracked>();
+                t->snap.seq = seq;
+                t->snap.scrollPos = (int)seq;
+                t->snap.busqueda = seq % 2 ? L"ranas" : L"rabas";
+                t->snap.platos.assign(seq % 7, (int)seq);
+                if (mailbox.Publish(std::move(t))) ++dropped;
+            }
+        });
+
+        // El consumidor nunca debe ver un seq menor o igual al anterior, ni un
+        // snapshot a medio armar
+        std::uint32_t last = 0;
+        while (last < kPublishes) {
+            auto t = mailbox.Take();
+            if (!t) { std::this_thread::yield(); continue; }
+            CHECK(t->snap.seq > last);
+            CHECK(t->snap.scrollPos == (int)t->snap.seq);
+            CHECK(t->snap.platos.size() == t->snap.seq % 7);
+            CHECK(t->snap.busqueda == (t->snap.seq % 2 ? L"ranas" : L"rabas"));
+            last = t->snap.seq;
+            ++taken;
+        }
+        producer.join();
+        CHECK(!mailbox.Take()); // el ltimo ya se tom
+    }
+    // Cada publicacin se tom o se descart exactamente una vez
+    CHECK(taken + dropped.load() == kPublishes);
+    CHECK(Tracked::live.load() == 0);
+    std::printf("publicados %u, tomados %u, descartados %u\n", kPublishes, taken, dropped.load());
+}
+
+// Lo que queda sin tomar se libera con el buzn
+static void DestroyWithPending() {
+    {
+        Mailbox<Tracked> mailbox;
+        mailbox.Publish(std::make_unique<Tracked>());
+        CHECK(mailbox.Publish(std::make_unique<Tracked>()));
+        CHECK(Tracked::live.load() == 1);
+    }
+    CHECK(Tracked::live.load() == 0);
+}
+
+// Qu layouts se aplican y cundo el hit-testing puede usar los rects
+static void LayoutGating() {
+    LayoutGate gate;
+    UiSnapshot s;
+    s.section = SEC_CARTA;
+    s.width = 1084;
+    s.height = 681;
+    s.platos = { 0, 1, 2, 3, 4 };
+
+    gate.Stamp(s);                 // 1: primer estado
+    CHECK(s.seq == 1 && !gate.Current());
+    CHECK(gate.Accept(1) && gate.Current());
+
+    // Elegir un plato o scrollear no mueve rects: los clicks siguen andando
+    s.plato = PLATO_GAMBAS;
+    gate.Stamp(s);                 // 2
+    CHECK(gate.Current());
+    s.especial = ESP_MONDONGO;
+    s.scrollPos = 120;
+    gate.Stamp(s);                 // 3
+    CHECK(gate.Current());
+    CHECK(gate.Accept(2) && gate.Accept(3));
+
+    // Filtrar la lista cambia la forma: el layout viejo ya no sirve
+    s.platos = { 2 };
+    gate.Stamp(s);                 // 4
+    CHECK(!gate.Current());
+    CHECK(!gate.Accept(3));
+    CHECK(!gate.Current());
+
+    // El buzn puede saltear el 4: alcanza con cualquier layout posterior
+    s.scrollPos = 0;
+    gate.Stamp(s);                 // 5
+    CHECK(!gate.Current());
+    CHECK(gate.Accept(5) && gate.Current());
+
+    // Cambio de seccin, de tamao o de DPI
+    const UiSnapshot base = s;
+    UiSnapshot t = base; t.section = SEC_HISTORIA;
+    CHECK(!LayoutGate::SameLayout(base, t));
+    t = base; t.width += 1;
+    CHECK(!LayoutGate::SameLayout(base, t));
+    t = base; t.dpi = 144;
+    CHECK(!LayoutGate::SameLayout(base, t));
+    t = base; t.especiales = { 1 };
+    CHECK(!LayoutGate::SameLayout(base, t));
+    t = base; t.plato = PLATO_RANAS; t.busqueda = L"x"; t.overdraw = true; t.fastScroll = true;
+    CHECK(LayoutGate::SameLayout(base, t));
+}
+
+int main() {
+    StressMailbox();
+    DestroyWithPending();
+    LayoutGating();
+    return TestResult("RenderStateTest");
+}